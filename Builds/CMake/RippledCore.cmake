@@ -364,6 +364,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/ledger/impl/LedgerToJson.cpp
   src/ripple/app/ledger/impl/LocalTxs.cpp
   src/ripple/app/ledger/impl/OpenLedger.cpp
+  src/ripple/app/ledger/impl/StateDeltaLog.cpp
   src/ripple/app/ledger/impl/TransactionAcquire.cpp
   src/ripple/app/ledger/impl/TransactionMaster.cpp
   src/ripple/app/main/Application.cpp
@@ -392,6 +393,7 @@ target_sources (rippled PRIVATE
   src/ripple/app/paths/AccountCurrencies.cpp
   src/ripple/app/paths/Credit.cpp
   src/ripple/app/paths/Flow.cpp
+  src/ripple/app/paths/PathRankCache.cpp
   src/ripple/app/paths/PathRequest.cpp
   src/ripple/app/paths/PathRequests.cpp
   src/ripple/app/paths/Pathfinder.cpp
@@ -662,6 +664,7 @@ target_sources (rippled PRIVATE
 #  src/test/app/Discrepancy_test.cpp
 #  src/test/app/Escrow_test.cpp
 #  src/test/app/FeeVote_test.cpp
+#  src/test/app/FetchPackDelta_test.cpp
 #  src/test/app/Flow_test.cpp
 #  src/test/app/Freeze_test.cpp
 #  src/test/app/HashRouter_test.cpp
@@ -673,7 +676,9 @@ target_sources (rippled PRIVATE
 #  src/test/app/MultiSign_test.cpp
 #  src/test/app/OfferStream_test.cpp
 #  src/test/app/Offer_test.cpp
+#  src/test/app/OrderBookDB_test.cpp
 #  src/test/app/OversizeMeta_test.cpp
+#  src/test/app/PathRankCache_test.cpp
 #  src/test/app/Path_test.cpp
 #  src/test/app/PayChan_test.cpp
 #  src/test/app/PayStrand_test.cpp
@@ -685,6 +690,7 @@ target_sources (rippled PRIVATE
 #  src/test/app/SetAuth_test.cpp
 #  src/test/app/SetRegularKey_test.cpp
 #  src/test/app/SetTrust_test.cpp
+#  src/test/app/StateDeltaLog_test.cpp
 #  src/test/app/Taker_test.cpp
 #  src/test/app/TheoreticalQuality_test.cpp
 #  src/test/app/Ticket_test.cpp
@@ -861,6 +867,8 @@ target_sources (rippled PRIVATE
 #  src/test/overlay/cluster_test.cpp
 #  src/test/overlay/short_read_test.cpp
 #  src/test/overlay/compression_test.cpp
+#  src/test/overlay/handshake_test.cpp
+#  src/test/overlay/reduce_relay_test.cpp
 #  #[===============================[
 #     test sources:
 #       subdir: peerfinder
@@ -49,8 +49,6 @@ AcceptedLedgerTx::AcceptedLedgerTx(
     Serializer s;
     met->add(s);
     mRawMeta = std::move(s.modData());
-
-    buildJson();
 }
 
 AcceptedLedgerTx::AcceptedLedgerTx(
@@ -67,7 +65,6 @@ AcceptedLedgerTx::AcceptedLedgerTx(
     , logs_(logs)
 {
     assert(ledger->open());
-    buildJson();
 }
 
 std::string
@@ -77,23 +74,23 @@ AcceptedLedgerTx::getEscMeta() const
     return sqlEscape(mRawMeta);
 }
 
-void
-AcceptedLedgerTx::buildJson()
+Json::Value
+AcceptedLedgerTx::getJson() const
 {
-    mJson = Json::objectValue;
-    mJson[jss::transaction] = mTxn->getJson(JsonOptions::none);
+    Json::Value ret(Json::objectValue);
+    ret[jss::transaction] = mTxn->getJson(JsonOptions::none);
 
     if (mMeta)
     {
-        mJson[jss::meta] = mMeta->getJson(JsonOptions::none);
-        mJson[jss::raw_meta] = strHex(mRawMeta);
+        ret[jss::meta] = mMeta->getJson(JsonOptions::none);
+        ret[jss::raw_meta] = strHex(mRawMeta);
     }
 
-    mJson[jss::result] = transHuman(mResult);
+    ret[jss::result] = transHuman(mResult);
 
     if (!mAffected.empty())
     {
-        Json::Value& affected = (mJson[jss::affected] = Json::arrayValue);
+        Json::Value& affected = (ret[jss::affected] = Json::arrayValue);
         for (auto const& account : mAffected)
             affected.append(accountCache_.toBase58(account));
     }
@@ -112,9 +109,11 @@ AcceptedLedgerTx::buildJson()
                 amount,
                 fhIGNORE_FREEZE,
                 logs_.journal("View"));
-            mJson[jss::transaction][jss::owner_funds] = ownerFunds.getText();
+            ret[jss::transaction][jss::owner_funds] = ownerFunds.getText();
         }
     }
+
+    return ret;
 }
 
 }  // namespace ripple
@@ -117,12 +117,19 @@ public:
     }
     std::string
     getEscMeta() const;
-    Json::Value
-    getJson() const
+    Blob const&
+    getRawMeta() const
     {
-        return mJson;
+        return mRawMeta;
     }
 
+    /** Returns the transaction in JSON form.
+
+        The JSON is built on each call; binary subscribers never need it.
+    */
+    Json::Value
+    getJson() const;
+
 private:
     std::shared_ptr<ReadView const> mLedger;
     std::shared_ptr<STTx const> mTxn;
@@ -130,12 +137,8 @@ private:
     TER mResult;
     boost::container::flat_set<AccountID> mAffected;
     Blob mRawMeta;
-    Json::Value mJson;
     AccountIDCache const& accountCache_;
     Logs& logs_;
-
-    void
-    buildJson();
 };
 
 }  // namespace ripple
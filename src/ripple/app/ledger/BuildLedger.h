@@ -78,5 +78,22 @@ buildLedger(
     Application& app,
     beast::Journal j);
 
+/** Rebuild a ledger by replaying its transactions, to check it
+
+    Like buildLedger, but nothing is written to the node store. Many ledgers
+    may be checked concurrently, each against its own parent.
+
+    @param replayData Data of the ledger to replay
+    @param app Handle to application instance
+    @param j Journal to use for logging
+    @return The rebuilt ledger, whose hash matches the replayed ledger's if
+            the replay reproduced it
+ */
+std::shared_ptr<Ledger const>
+verifyReplay(
+    LedgerReplay const& replayData,
+    Application& app,
+    beast::Journal j);
+
 }  // namespace ripple
 #endif
@@ -132,8 +132,16 @@ private:
     void
     filterNodes(
         std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+        std::shared_ptr<Peer> const& peer,
         TriggerReason reason);
 
+    /** Adjust how many nodes we ask a peer for at once.
+
+        Called with a lock after processing a reply from the peer.
+    */
+    void
+    updateWindow(std::shared_ptr<Peer> const& peer, int useful);
+
     void
     trigger(std::shared_ptr<Peer> const&, TriggerReason);
 
@@ -205,6 +213,9 @@ private:
 
     std::set<uint256> mRecentNodes;
 
+    // How many nodes to ask each peer for in response to a reply
+    std::map<Peer::id_t, std::size_t> mWindows;
+
     SHAMapAddNode mStats;
 
     // Data we have received from peers
@@ -24,6 +24,7 @@
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/OrderBookDB.h>
 #include <ripple/app/ledger/PendingSaves.h>
+#include <ripple/app/ledger/StateDeltaLog.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/HashRouter.h>
@@ -260,6 +261,7 @@ Ledger::Ledger(Ledger const& prevLedger, NetClock::time_point closeTime)
           SHAMapType::TRANSACTION,
           prevLedger.stateMap_->family()))
     , stateMap_(prevLedger.stateMap_->snapShot(true))
+    , stateDeltas_(prevLedger.stateDeltas_)
     , fees_(prevLedger.fees_)
     , rules_(prevLedger.rules_)
 {
@@ -388,6 +390,13 @@ deserializeTxPlusMeta(SHAMapItem const& item)
 bool
 Ledger::exists(Keylet const& k) const
 {
+    if (stateDeltas_)
+    {
+        if (auto const item =
+                stateDeltas_->lookup(info_.seq, info_.hash, k.key))
+            return *item != nullptr;
+    }
+
     // VFALCO NOTE Perhaps check the type for debug builds?
     return stateMap_->hasItem(k.key);
 }
@@ -411,7 +420,13 @@ Ledger::read(Keylet const& k) const
         assert(false);
         return nullptr;
     }
-    auto const& item = stateMap_->peekItem(k.key);
+    std::shared_ptr<SHAMapItem const> item;
+    if (auto const logged = stateDeltas_
+            ? stateDeltas_->lookup(info_.seq, info_.hash, k.key)
+            : boost::none)
+        item = *logged;
+    else
+        item = stateMap_->peekItem(k.key);
     if (!item)
         return nullptr;
     auto sle = std::make_shared<SLE>(
@@ -883,8 +898,6 @@ saveValidatedLedger(
         "DELETE FROM Transactions WHERE LedgerSeq = %u;");
     static boost::format deleteTrans2(
         "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-    static boost::format deleteAcctTrans(
-        "DELETE FROM AccountTransactions WHERE TransID = '%s';");
 
     if (!ledger->info().accountHash.isNonZero())
     {
@@ -947,7 +960,26 @@ saveValidatedLedger(
         *db << boost::str(deleteTrans1 % seq);
         *db << boost::str(deleteTrans2 % seq);
 
-        std::string const ledgerSeq(std::to_string(seq));
+        // The per-transaction statements are prepared once and re-executed
+        // with bound values; SQLite then only has to parse each of them a
+        // single time per ledger instead of once per transaction or row.
+        std::string txnId;
+        std::string account;
+        std::uint32_t txnSeq = 0;
+
+        soci::statement deleteAcctTrans =
+            (db->prepare << "DELETE FROM AccountTransactions "
+                            "WHERE TransID = :txnId;",
+             soci::use(txnId));
+
+        soci::statement insertAcctTrans =
+            (db->prepare << "INSERT INTO AccountTransactions "
+                            "(TransID, Account, LedgerSeq, TxnSeq) "
+                            "VALUES (:txnId, :account, :ledgerSeq, :txnSeq);",
+             soci::use(txnId),
+             soci::use(account),
+             soci::use(seq),
+             soci::use(txnSeq));
 
         for (auto const& [_, acceptedLedgerTx] : aLedger->getMap())
         {
@@ -956,48 +988,22 @@ saveValidatedLedger(
 
             app.getMasterTransaction().inLedger(transactionID, seq);
 
-            std::string const txnId(to_string(transactionID));
-            std::string const txnSeq(
-                std::to_string(acceptedLedgerTx->getTxnSeq()));
+            txnId = to_string(transactionID);
+            txnSeq = acceptedLedgerTx->getTxnSeq();
 
-            *db << boost::str(deleteAcctTrans % transactionID);
+            deleteAcctTrans.execute(true);
 
             auto const& accts = acceptedLedgerTx->getAffected();
 
             if (!accts.empty())
             {
-                std::string sql(
-                    "INSERT INTO AccountTransactions "
-                    "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                // Try to make an educated guess on how much space we'll need
-                // for our arguments. In argument order we have:
-                // 64 + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                sql.reserve(sql.length() + (accts.size() * 128));
-
-                bool first = true;
-                for (auto const& account : accts)
+                for (auto const& acct : accts)
                 {
-                    if (!first)
-                        sql += ", ('";
-                    else
-                    {
-                        sql += "('";
-                        first = false;
-                    }
-
-                    sql += txnId;
-                    sql += "','";
-                    sql += app.accountIDCache().toBase58(account);
-                    sql += "',";
-                    sql += ledgerSeq;
-                    sql += ",";
-                    sql += txnSeq;
-                    sql += ")";
+                    account = app.accountIDCache().toBase58(acct);
+                    insertAcctTrans.execute(true);
                 }
-                sql += ";";
-                JLOG(j.trace()) << "ActTx: " << sql;
-                *db << sql;
+                JLOG(j.trace()) << "ActTx: " << txnId << " affects "
+                                << accts.size() << " accounts";
             }
             else
             {
@@ -1213,13 +1219,14 @@ loadLedgerHelper(std::string const& sqlSuffix, Application& app, bool acquire)
 static void
 finishLoadByIndexOrHash(
     std::shared_ptr<Ledger> const& ledger,
-    Config const& config,
+    Application& app,
     beast::Journal j)
 {
     if (!ledger)
         return;
 
-    ledger->setImmutable(config);
+    ledger->setImmutable(app.config());
+    ledger->setStateDeltas(app.getLedgerMaster().getStateDeltas());
 
     JLOG(j.trace()) << "Loaded ledger: " << to_string(ledger->info().hash);
 
@@ -1237,7 +1244,7 @@ loadByIndex(std::uint32_t ledgerIndex, Application& app, bool acquire)
             loadLedgerHelper(s.str(), app, acquire);
     }
 
-    finishLoadByIndexOrHash(ledger, app.config(), app.journal("Ledger"));
+    finishLoadByIndexOrHash(ledger, app, app.journal("Ledger"));
     return ledger;
 }
 
@@ -1252,7 +1259,7 @@ loadByHash(uint256 const& ledgerHash, Application& app, bool acquire)
             loadLedgerHelper(s.str(), app, acquire);
     }
 
-    finishLoadByIndexOrHash(ledger, app.config(), app.journal("Ledger"));
+    finishLoadByIndexOrHash(ledger, app, app.journal("Ledger"));
 
     assert(!ledger || ledger->info().hash == ledgerHash);
 
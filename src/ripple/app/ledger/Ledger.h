@@ -38,6 +38,7 @@ namespace ripple {
 
 class Application;
 class Job;
+class StateDeltaLog;
 class TransactionMaster;
 
 class SqliteStatement;
@@ -313,6 +314,17 @@ public:
     bool
     addSLE(SLE const& sle);
 
+    /** Answer point reads from a log of recent state changes.
+
+        Reads of entries the log knows about no longer walk the state
+        map. Must be called before the ledger is shared.
+    */
+    void
+    setStateDeltas(std::shared_ptr<StateDeltaLog const> log)
+    {
+        stateDeltas_ = std::move(log);
+    }
+
     //--------------------------------------------------------------------------
 
     void
@@ -383,6 +395,7 @@ private:
 
     std::shared_ptr<SHAMap> txMap_;
     std::shared_ptr<SHAMap> stateMap_;
+    std::shared_ptr<StateDeltaLog const> stateDeltas_;
 
     // Protects fee variables
     std::mutex mutable mutex_;
@@ -27,6 +27,7 @@
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerHolder.h>
 #include <ripple/app/ledger/LedgerReplay.h>
+#include <ripple/app/ledger/StateDeltaLog.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/basics/RangeSet.h>
@@ -35,6 +36,7 @@
 #include <ripple/beast/insight/Collector.h>
 #include <ripple/beast/utility/PropertyStream.h>
 #include <ripple/core/Stoppable.h>
+#include <ripple/overlay/Peer.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/RippleLedgerHash.h>
 #include <ripple/protocol/STValidation.h>
@@ -45,7 +47,6 @@
 
 namespace ripple {
 
-class Peer;
 class Transaction;
 
 // Tracks the current ledger and any ledgers in the process of closing
@@ -259,6 +260,13 @@ public:
     std::unique_ptr<LedgerReplay>
     releaseReplay();
 
+    /** Returns the log of recent state changes, if one is configured. */
+    std::shared_ptr<StateDeltaLog const>
+    getStateDeltas() const
+    {
+        return stateDeltas_;
+    }
+
     // Fetch Packs
     void
     gotFetchPack(bool progress, std::uint32_t seq);
@@ -266,6 +274,28 @@ public:
     void
     addFetchPack(uint256 const& hash, std::shared_ptr<Blob> data);
 
+    /** Check that a delta fetch pack was requested from a peer.
+
+        Each request is only accepted once.
+
+        @param hash The hash of the ledger the pack was requested for.
+        @param peer The peer that sent the pack.
+    */
+    bool
+    takeFetchPackDelta(uint256 const& hash, Peer::id_t peer);
+
+    /** Add a fetch pack that was sent as a delta.
+
+        The state nodes of each ledger in the pack are rebuilt from the
+        changed entries, starting from the ledger the pack was requested
+        for, and checked against the ledger's header. Ledgers we already
+        have are not rebuilt. The peer is charged if the pack is invalid.
+    */
+    void
+    addFetchPackDelta(
+        std::weak_ptr<Peer> const& wPeer,
+        std::shared_ptr<protocol::TMGetObjectByHash> const& packet);
+
     boost::optional<Blob>
     getFetchPack(uint256 const& hash) override;
 
@@ -276,6 +306,24 @@ public:
         uint256 haveLedgerHash,
         UptimeClock::time_point uptime);
 
+    /** Build the reply to a fetch pack request.
+
+        Adds ledgers to `reply` starting with `wantLedger`, the parent of
+        `haveLedger`, and walking back until the reply is large enough or
+        a second has passed since `uptime`.
+
+        @param deltaLimit The most entries a ledger may change for the
+                          changes to be sent as a delta.
+    */
+    void
+    buildFetchPack(
+        protocol::TMGetObjectByHash const& request,
+        std::shared_ptr<Ledger const> haveLedger,
+        std::shared_ptr<Ledger const> wantLedger,
+        protocol::TMGetObjectByHash& reply,
+        UptimeClock::time_point uptime,
+        int deltaLimit = 16384);
+
     std::size_t
     getFetchPackCacheSize() const;
 
@@ -369,6 +417,9 @@ private:
 
     std::unique_ptr<detail::LedgerCleaner> mLedgerCleaner;
 
+    // Recent changes to the state of published ledgers
+    std::shared_ptr<StateDeltaLog> stateDeltas_;
+
     // Publish thread is running.
     bool mAdvanceThread{false};
 
@@ -403,6 +454,12 @@ private:
 
     std::uint32_t fetch_seq_{0};
 
+    // Delta fetch packs requested and not yet received, by the hash of the
+    // ledger they were requested for
+    std::mutex fetch_pack_deltas_mutex_;
+    hash_map<uint256, std::pair<Peer::id_t, UptimeClock::time_point>>
+        fetch_pack_deltas_;
+
     // Try to keep a validator from switching from test to live network
     // without first wiping the database.
     LedgerIndex const max_ledger_difference_{1000000};
@@ -147,6 +147,10 @@ public:
             The list of local transactions are applied
             to the new open view.
 
+            Transactions that are already in the accepted
+            ledger, or that were already applied to the
+            new open view, are skipped.
+
             The optional modify function f is called
             to perform further modifications to the
             open view, atomically. Changes made in
@@ -230,7 +234,10 @@ OpenLedger::apply(
             // throw since it may be transformed.
             auto const tx = *iter;
             auto const txId = tx->getTransactionID();
-            if (check.txExists(txId))
+            // Skip transactions the closed ledger already holds or
+            // that an earlier step applied to this view. Applying
+            // them again can only fail, after a full preclaim.
+            if (check.txExists(txId) || view.txExists(txId))
                 continue;
             auto const result =
                 apply_one(app, view, tx, true, flags, shouldRecover[txId], j);
@@ -24,9 +24,22 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/protocol/Indexes.h>
+#include <algorithm>
 
 namespace ripple {
 
+// The book described by a page of one of its directories
+static Book
+getDirectoryBook(SLE const& sle)
+{
+    Book book;
+    book.in.currency = sle.getFieldH160(sfTakerPaysCurrency);
+    book.in.account = sle.getFieldH160(sfTakerPaysIssuer);
+    book.out.account = sle.getFieldH160(sfTakerGetsIssuer);
+    book.out.currency = sle.getFieldH160(sfTakerGetsCurrency);
+    return book;
+}
+
 OrderBookDB::OrderBookDB(Application& app, Stoppable& parent)
     : Stoppable("OrderBookDB", parent)
     , app_(app)
@@ -47,22 +60,25 @@ OrderBookDB::setup(std::shared_ptr<ReadView const> const& ledger)
 {
     {
         std::lock_guard sl(mLock);
-        auto seq = ledger->info().seq;
-
-        // Do a full update every 256 ledgers
-        if (mSeq != 0)
+        auto const& info = ledger->info();
+        auto const seq = info.seq;
+
+        // The books follow every validated transaction, so a full update
+        // is only needed the first time and when ledgers were skipped.
+        if (mSeq != 0 &&
+            ((seq == mLastSeq && info.hash == mLastHash) ||
+             (seq == mLastSeq + 1 && info.parentHash == mLastHash)))
         {
-            if (seq == mSeq)
-                return;
-            if ((seq > mSeq) && ((seq - mSeq) < 256))
-                return;
-            if ((seq < mSeq) && ((mSeq - seq) < 16))
-                return;
+            mSeq = seq;
+            return;
         }
 
         JLOG(j_.debug()) << "Advancing from " << mSeq << " to " << seq;
 
         mSeq = seq;
+        mLastSeq = seq;
+        mLastHash = info.hash;
+        mUpdating = app_.config().PATH_SEARCH_MAX != 0;
     }
 
     if (app_.config().PATH_SEARCH_MAX == 0)
@@ -71,17 +87,22 @@ OrderBookDB::setup(std::shared_ptr<ReadView const> const& ledger)
     }
     else if (app_.config().standalone())
         update(ledger);
-    else
-        app_.getJobQueue().addJob(
-            jtUPDATE_PF, "OrderBookDB::update", [this, ledger](Job&) {
-                update(ledger);
-            });
+    else if (!app_.getJobQueue().addJob(
+                 jtUPDATE_PF, "OrderBookDB::update", [this, ledger](Job&) {
+                     update(ledger);
+                 }))
+    {
+        std::lock_guard sl(mLock);
+        mUpdating = false;
+        mTouched.clear();
+        mTouchedLedger.reset();
+    }
 }
 
 void
 OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
 {
-    hash_set<uint256> seen;
+    hash_map<uint256, OrderBook::pointer> books;
     OrderBookDB::IssueToOrderBook destMap;
     OrderBookDB::IssueToOrderBook sourceMap;
     hash_set<Issue> XRPBooks;
@@ -94,9 +115,18 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
         return;
     }
 
-    // walk through the entire ledger looking for orderbook entries
-    int books = 0;
+    // The books are kept up to date as ledgers are validated, so this
+    // full walk is only needed to build them in the first place and to
+    // check them after a gap.
+    auto const abandon = [this] {
+        std::lock_guard sl(mLock);
+        mSeq = 0;
+        mUpdating = false;
+        mTouched.clear();
+        mTouchedLedger.reset();
+    };
 
+    // walk through the entire ledger looking for orderbook entries
     try
     {
         for (auto& sle : ledger->sles)
@@ -105,8 +135,7 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
             {
                 JLOG(j_.info())
                     << "OrderBookDB::update exiting due to isStopping";
-                std::lock_guard sl(mLock);
-                mSeq = 0;
+                abandon();
                 return;
             }
 
@@ -114,21 +143,17 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
                 sle->isFieldPresent(sfExchangeRate) &&
                 sle->getFieldH256(sfRootIndex) == sle->key())
             {
-                Book book;
-                book.in.currency = sle->getFieldH160(sfTakerPaysCurrency);
-                book.in.account = sle->getFieldH160(sfTakerPaysIssuer);
-                book.out.account = sle->getFieldH160(sfTakerGetsIssuer);
-                book.out.currency = sle->getFieldH160(sfTakerGetsCurrency);
+                Book const book = getDirectoryBook(*sle);
 
                 uint256 index = getBookBase(book);
-                if (seen.insert(index).second)
+                if (books.count(index) == 0)
                 {
                     auto orderBook = std::make_shared<OrderBook>(index, book);
+                    books.emplace(index, orderBook);
                     sourceMap[book.in].push_back(orderBook);
                     destMap[book.out].push_back(orderBook);
                     if (isXRP(book.out))
                         XRPBooks.insert(book.in);
-                    ++books;
                 }
             }
         }
@@ -136,56 +161,124 @@ OrderBookDB::update(std::shared_ptr<ReadView const> const& ledger)
     catch (SHAMapMissingNode const& mn)
     {
         JLOG(j_.info()) << "OrderBookDB::update: " << mn.what();
-        std::lock_guard sl(mLock);
-        mSeq = 0;
+        abandon();
         return;
     }
 
-    JLOG(j_.debug()) << "OrderBookDB::update< " << books << " books found";
+    JLOG(j_.debug()) << "OrderBookDB::update< " << books.size()
+                     << " books found";
     {
         std::lock_guard sl(mLock);
 
+        if (mBooks.size() != books.size())
+        {
+            JLOG(j_.debug()) << "OrderBookDB::update: had " << mBooks.size()
+                             << " books";
+        }
+
         mXRPBooks.swap(XRPBooks);
         mSourceMap.swap(sourceMap);
         mDestMap.swap(destMap);
+        mBooks.swap(books);
+
+        // Catch up with the ledgers validated during the walk
+        try
+        {
+            if (mTouchedLedger)
+            {
+                for (auto const& base : mTouched)
+                    refreshBook(*mTouchedLedger, base);
+            }
+        }
+        catch (SHAMapMissingNode const& mn)
+        {
+            JLOG(j_.info()) << "OrderBookDB::update: " << mn.what();
+            mSeq = 0;
+        }
+
+        mUpdating = false;
+        mTouched.clear();
+        mTouchedLedger.reset();
     }
     app_.getLedgerMaster().newOrderBookDB();
 }
 
+bool
+OrderBookDB::rawAddBook(Book const& book)
+{
+    uint256 index = getBookBase(book);
+    auto orderBook = std::make_shared<OrderBook>(index, book);
+
+    if (!mBooks.emplace(index, orderBook).second)
+        return false;
+
+    mSourceMap[book.in].push_back(orderBook);
+    mDestMap[book.out].push_back(orderBook);
+    if (isXRP(book.out))
+        mXRPBooks.insert(book.in);
+    return true;
+}
+
 void
-OrderBookDB::addOrderBook(Book const& book)
+OrderBookDB::rawRemoveBook(uint256 const& base)
 {
-    bool toXRP = isXRP(book.out);
-    std::lock_guard sl(mLock);
+    auto const it = mBooks.find(base);
+    if (it == mBooks.end())
+        return;
 
-    if (toXRP)
+    auto const orderBook = it->second;
+    auto const& book = orderBook->book();
+    mBooks.erase(it);
+
+    auto const remove = [&orderBook](
+                            IssueToOrderBook& map, Issue const& issue) {
+        auto const list = map.find(issue);
+        if (list == map.end())
+            return;
+        auto& books = list->second;
+        books.erase(
+            std::remove(books.begin(), books.end(), orderBook), books.end());
+        if (books.empty())
+            map.erase(list);
+    };
+
+    remove(mSourceMap, book.in);
+    remove(mDestMap, book.out);
+    if (isXRP(book.out))
+        mXRPBooks.erase(book.in);
+}
+
+void
+OrderBookDB::refreshBook(ReadView const& ledger, uint256 const& base)
+{
+    // A book exists as long as it has a directory at any quality
+    auto const dir = ledger.succ(base, getQualityNext(base));
+    if (!dir)
     {
-        // We don't want to search through all the to-XRP or from-XRP order
-        // books!
-        for (auto ob : mSourceMap[book.in])
-        {
-            if (isXRP(ob->getCurrencyOut()))  // also to XRP
-                return;
-        }
+        JLOG(j_.trace()) << "Removing book " << base;
+        rawRemoveBook(base);
+        return;
     }
-    else
+
+    if (mBooks.count(base) != 0)
+        return;
+
+    if (auto const sle = ledger.read(keylet::page(*dir)))
     {
-        for (auto ob : mDestMap[book.out])
+        Book const book = getDirectoryBook(*sle);
+        if (getBookBase(book) == base && rawAddBook(book))
         {
-            if (ob->getCurrencyIn() == book.in.currency &&
-                ob->getIssuerIn() == book.in.account)
-            {
-                return;
-            }
+            JLOG(j_.trace()) << "Adding book " << base;
         }
     }
-    uint256 index = getBookBase(book);
-    auto orderBook = std::make_shared<OrderBook>(index, book);
+}
 
-    mSourceMap[book.in].push_back(orderBook);
-    mDestMap[book.out].push_back(orderBook);
-    if (toXRP)
-        mXRPBooks.insert(book.in);
+void
+OrderBookDB::addOrderBook(Book const& book)
+{
+    std::lock_guard sl(mLock);
+    if (rawAddBook(book))
+        mUnconfirmed.insert(getBookBase(book));
 }
 
 // return list of all orderbooks that want this issuerID and currencyID
@@ -242,15 +335,72 @@ OrderBookDB::getBookListeners(Book const& book)
     return ret;
 }
 
+void
+OrderBookDB::follow(std::shared_ptr<ReadView const> const& ledger)
+{
+    std::lock_guard sl(mLock);
+
+    mLastSeq = ledger->info().seq;
+    mLastHash = ledger->info().hash;
+
+    for (auto const& base : mUnconfirmed)
+        refreshBook(*ledger, base);
+    mUnconfirmed.clear();
+}
+
 // Based on the meta, send the meta to the streams that are listening.
 // We need to determine which streams a given meta effects.
 void
 OrderBookDB::processTxn(
     std::shared_ptr<ReadView const> const& ledger,
     const AcceptedLedgerTx& alTx,
-    Json::Value const& jvObj)
+    PublishedJson& msg)
 {
     std::lock_guard sl(mLock);
+
+    // Even failed transactions may remove unfunded offers, and with them
+    // the last directory of a book.
+    if (app_.config().PATH_SEARCH_MAX != 0)
+    {
+        for (auto& node : alTx.getMeta()->getNodes())
+        {
+            try
+            {
+                if (node.getFieldU16(sfLedgerEntryType) != ltDIR_NODE)
+                    continue;
+
+                SField const* field = nullptr;
+                if (node.getFName() == sfCreatedNode)
+                    field = &sfNewFields;
+                else if (node.getFName() == sfDeletedNode)
+                    field = &sfFinalFields;
+
+                auto data = field ? dynamic_cast<const STObject*>(
+                                        node.peekAtPField(*field))
+                                  : nullptr;
+
+                // Owner directories have no exchange rate
+                if (!data || !data->isFieldPresent(sfExchangeRate))
+                    continue;
+
+                auto const base = keylet::quality(
+                    {ltDIR_NODE, node.getFieldH256(sfLedgerIndex)}, 0);
+                refreshBook(*ledger, base.key);
+
+                if (mUpdating)
+                {
+                    mTouched.insert(base.key);
+                    mTouchedLedger = ledger;
+                }
+            }
+            catch (std::exception const&)
+            {
+                JLOG(j_.info())
+                    << "Book directory not updated in OrderBookDB::processTxn";
+            }
+        }
+    }
+
     if (alTx.getResult() == tesSUCCESS)
     {
         // For this particular transaction, maintain the set of unique
@@ -296,7 +446,7 @@ OrderBookDB::processTxn(
                             auto listeners = getBookListeners(b);
                             if (listeners)
                             {
-                                listeners->publish(jvObj, havePublished);
+                                listeners->publish(msg, havePublished);
                             }
                         }
                     }
@@ -40,6 +40,10 @@ public:
     void
     invalidate();
 
+    /** Add a book created in the open ledger, so that paths can use it
+        right away. It is dropped again if the next validated ledger
+        doesn't have it.
+    */
     void
     addOrderBook(Book const&);
 
@@ -61,19 +65,41 @@ public:
     BookListeners::pointer
     makeBookListeners(Book const&);
 
-    // see if this txn effects any orderbook
+    /** See if this txn effects any orderbook.
+
+        Also keeps the order books up to date with the book directories
+        that the transaction created or deleted, so that the whole ledger
+        need not be rescanned as it advances.
+    */
     void
     processTxn(
         std::shared_ptr<ReadView const> const& ledger,
         const AcceptedLedgerTx& alTx,
-        Json::Value const& jvObj);
+        PublishedJson& msg);
+
+    /** The books now follow this validated ledger.
+
+        Called once all of its transactions have been processed, even if
+        it has none.
+    */
+    void
+    follow(std::shared_ptr<ReadView const> const& ledger);
 
     using IssueToOrderBook = hash_map<Issue, OrderBook::List>;
 
 private:
-    void
+    // The following require mLock to be held
+
+    bool
     rawAddBook(Book const&);
 
+    void
+    rawRemoveBook(uint256 const& base);
+
+    // Add or remove the book with this base to match the ledger
+    void
+    refreshBook(ReadView const& ledger, uint256 const& base);
+
     Application& app_;
 
     // by ci/ii
@@ -85,6 +111,15 @@ private:
     // does an order book to XRP exist
     hash_set<Issue> mXRPBooks;
 
+    // by book base
+    hash_map<uint256, OrderBook::pointer> mBooks;
+
+    // Books touched while a full update is in progress. They are
+    // refreshed from the latest ledger once the update completes.
+    bool mUpdating = false;
+    hash_set<uint256> mTouched;
+    std::shared_ptr<ReadView const> mTouchedLedger;
+
     std::recursive_mutex mLock;
 
     using BookToListenersMap = hash_map<Book, BookListeners::pointer>;
@@ -93,6 +128,14 @@ private:
 
     std::uint32_t mSeq;
 
+    // The last ledger the books followed
+    std::uint32_t mLastSeq = 0;
+    uint256 mLastHash;
+
+    // Books added from the open ledger and not yet checked against a
+    // validated one
+    hash_set<uint256> mUnconfirmed;
+
     beast::Journal const j_;
 };
 
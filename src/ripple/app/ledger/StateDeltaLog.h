@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_STATEDELTALOG_H_INCLUDED
+#define RIPPLE_APP_LEDGER_STATEDELTALOG_H_INCLUDED
+
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/Protocol.h>
+#include <ripple/shamap/SHAMapItem.h>
+#include <boost/optional.hpp>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace ripple {
+
+class Ledger;
+
+/** Remembers which state entries recent validated ledgers changed.
+
+    Ledgers are appended in order as they are published. For each one
+    the log records, against its parent, every state entry that was
+    created, modified or deleted, along with the new item.
+
+    A point lookup against a retained ledger is answered from memory when
+    the entry changed at or after the oldest retained ledger. Otherwise
+    the caller falls back to walking the ledger's state map, which may
+    have to fetch inner nodes from the NodeStore.
+
+    Thread safety:
+        May be called concurrently from any thread. Lookups only take a
+        shared lock, so readers don't contend with each other.
+*/
+class StateDeltaLog
+{
+public:
+    /** Create a log.
+
+        @param ledgers The number of ledgers to retain.
+    */
+    StateDeltaLog(std::uint32_t ledgers, beast::Journal journal);
+
+    StateDeltaLog(StateDeltaLog const&) = delete;
+    StateDeltaLog&
+    operator=(StateDeltaLog const&) = delete;
+
+    /** Record the changes a newly published ledger made.
+
+        If the ledger does not follow the last one appended, the log
+        restarts from it.
+    */
+    void
+    append(std::shared_ptr<Ledger const> const& ledger);
+
+    /** Look up a state entry as of a ledger.
+
+        @param seq The sequence of the ledger to read.
+        @param hash The hash of the ledger to read.
+        @param key The key of the state entry.
+
+        @return Nothing if the log cannot answer for this ledger and key.
+                Otherwise, the entry's item in that ledger, which is null
+                if the entry did not exist.
+    */
+    boost::optional<std::shared_ptr<SHAMapItem const>>
+    lookup(LedgerIndex seq, uint256 const& hash, uint256 const& key) const;
+
+    /** Returns the range of ledgers the log can answer for, if any. */
+    boost::optional<std::pair<LedgerIndex, LedgerIndex>>
+    range() const;
+
+private:
+    struct Changes
+    {
+        LedgerIndex seq;
+        uint256 hash;
+        std::vector<uint256> keys;
+    };
+
+    using History =
+        std::vector<std::pair<LedgerIndex, std::shared_ptr<SHAMapItem const>>>;
+
+    std::uint32_t const size_;
+    beast::Journal const j_;
+
+    std::shared_mutex mutable mutex_;
+
+    // The last ledger appended, which the next one is compared against
+    std::shared_ptr<Ledger const> last_;
+
+    // The keys each retained ledger changed, oldest first
+    std::deque<Changes> ledgers_;
+
+    // For each key, the items it took in retained ledgers, oldest first
+    hash_map<uint256, History> items_;
+};
+
+}  // namespace ripple
+
+#endif
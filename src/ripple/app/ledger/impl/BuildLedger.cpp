@@ -33,6 +33,7 @@ namespace ripple {
    It is responsible for adding transactions to the open view to generate the
    new ledger. It is generic since the mechanics differ for consensus
    generated ledgers versus replayed ledgers.
+   Unless flush is false, the new ledger's nodes are written to the node store.
 */
 template <class ApplyTxs>
 std::shared_ptr<Ledger>
@@ -43,7 +44,8 @@ buildLedgerImpl(
     NetClock::duration closeResolution,
     Application& app,
     beast::Journal j,
-    ApplyTxs&& applyTxs)
+    ApplyTxs&& applyTxs,
+    bool flush = true)
 {
     auto built = std::make_shared<Ledger>(*parent, closeTime);
 
@@ -63,6 +65,7 @@ buildLedgerImpl(
     }
 
     built->updateSkipList();
+    if (flush)
     {
         // Write the final version of all modified SHAMap
         // nodes to the node store to preserve the new LCL
@@ -211,13 +214,13 @@ buildLedger(
         });
 }
 
-// Build a ledger by replaying
-std::shared_ptr<Ledger>
-buildLedger(
+static std::shared_ptr<Ledger>
+buildReplayImpl(
     LedgerReplay const& replayData,
     ApplyFlags applyFlags,
     Application& app,
-    beast::Journal j)
+    beast::Journal j,
+    bool flush)
 {
     auto const& replayLedger = replayData.replay();
 
@@ -233,7 +236,29 @@ buildLedger(
         [&](OpenView& accum, std::shared_ptr<Ledger> const& built) {
             for (auto& tx : replayData.orderedTxns())
                 applyTransaction(app, accum, *tx.second, false, applyFlags, j);
-        });
+        },
+        flush);
+}
+
+// Build a ledger by replaying
+std::shared_ptr<Ledger>
+buildLedger(
+    LedgerReplay const& replayData,
+    ApplyFlags applyFlags,
+    Application& app,
+    beast::Journal j)
+{
+    return buildReplayImpl(replayData, applyFlags, app, j, true);
+}
+
+// Rebuild a ledger to check it
+std::shared_ptr<Ledger const>
+verifyReplay(
+    LedgerReplay const& replayData,
+    Application& app,
+    beast::Journal j)
+{
+    return buildReplayImpl(replayData, tapNONE, app, j, false);
 }
 
 }  // namespace ripple
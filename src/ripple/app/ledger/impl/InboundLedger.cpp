@@ -57,12 +57,20 @@ enum {
 
     // Number of nodes to find initially
     ,
-    missingNodesFind = 256
+    missingNodesFind = 512
 
-    // Number of nodes to request for a reply
+    // Number of nodes to request initially for a reply
     ,
     reqNodesReply = 128
 
+    // Fewest nodes to request from a slow peer for a reply
+    ,
+    reqNodesReplyMin = 32
+
+    // Most nodes to request from a fast peer for a reply
+    ,
+    reqNodesReplyMax = 256
+
     // Number of nodes to request blindly
     ,
     reqNodes = 8
@@ -318,6 +326,9 @@ InboundLedger::tryDB(NodeStore::Database& srcDB)
                 mLedger.reset();
                 mFailed = true;
             }
+            else if (mReason != Reason::SHARD)
+                mLedger->setStateDeltas(
+                    app_.getLedgerMaster().getStateDeltas());
         };
 
         // Try to fetch the ledger header from the DB
@@ -712,7 +723,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
                 }
                 else
                 {
-                    filterNodes(nodes, reason);
+                    filterNodes(nodes, peer, reason);
 
                     if (!nodes.empty())
                     {
@@ -778,7 +789,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
             }
             else
             {
-                filterNodes(nodes, reason);
+                filterNodes(nodes, peer, reason);
 
                 if (!nodes.empty())
                 {
@@ -814,6 +825,7 @@ InboundLedger::trigger(std::shared_ptr<Peer> const& peer, TriggerReason reason)
 void
 InboundLedger::filterNodes(
     std::vector<std::pair<SHAMapNodeID, uint256>>& nodes,
+    std::shared_ptr<Peer> const& peer,
     TriggerReason reason)
 {
     // Sort nodes so that the ones we haven't recently
@@ -843,8 +855,17 @@ InboundLedger::filterNodes(
         nodes.erase(dup, nodes.end());
     }
 
-    std::size_t const limit =
-        (reason == TriggerReason::reply) ? reqNodesReply : reqNodes;
+    std::size_t limit = reqNodes;
+    if (reason == TriggerReason::reply)
+    {
+        limit = reqNodesReply;
+        if (peer)
+        {
+            if (auto const iter = mWindows.find(peer->id());
+                iter != mWindows.end())
+                limit = iter->second;
+        }
+    }
 
     if (nodes.size() > limit)
         nodes.resize(limit);
@@ -853,6 +874,19 @@ InboundLedger::filterNodes(
         mRecentNodes.insert(n.second);
 }
 
+void
+InboundLedger::updateWindow(std::shared_ptr<Peer> const& peer, int useful)
+{
+    auto& window = mWindows.emplace(peer->id(), reqNodesReply).first->second;
+
+    // Peers usually send the children of the nodes we ask for too, so one
+    // that keeps up returns at least as many useful nodes as we requested.
+    if (useful >= static_cast<int>(window))
+        window = std::min<std::size_t>(window * 2, reqNodesReplyMax);
+    else if (useful < static_cast<int>(window / 4))
+        window = std::max<std::size_t>(window / 2, reqNodesReplyMin);
+}
+
 /** Take ledger header data
     Call with a lock
 */
@@ -881,6 +915,8 @@ InboundLedger::takeHeader(std::string const& data)
     }
     if (mSeq == 0)
         mSeq = mLedger->info().seq;
+    if (mReason != Reason::SHARD)
+        mLedger->setStateDeltas(app_.getLedgerMaster().getStateDeltas());
     mLedger->stateMap().setLedgerSeq(mSeq);
     mLedger->txMap().setLedgerSeq(mSeq);
     mHaveHeader = true;
@@ -1210,8 +1246,8 @@ InboundLedger::processData(
 void
 InboundLedger::runData()
 {
-    std::shared_ptr<Peer> chosenPeer;
-    int chosenPeerCount = -1;
+    // The useful nodes each peer sent, in the order the peers responded
+    std::vector<std::pair<std::shared_ptr<Peer>, int>> useful;
 
     std::vector<PeerDataPairType> data;
 
@@ -1230,24 +1266,43 @@ InboundLedger::runData()
             data.swap(mReceivedData);
         }
 
-        // Select the peer that gives us the most nodes that are useful,
-        // breaking ties in favor of the peer that responded first.
         for (auto& entry : data)
         {
             if (auto peer = entry.first.lock())
             {
                 int count = processData(peer, *(entry.second));
-                if (count > chosenPeerCount)
-                {
-                    chosenPeerCount = count;
-                    chosenPeer = std::move(peer);
-                }
+                auto iter = std::find_if(
+                    useful.begin(), useful.end(), [&peer](auto const& u) {
+                        return u.first == peer;
+                    });
+                if (iter == useful.end())
+                    useful.emplace_back(std::move(peer), count);
+                else
+                    iter->second += count;
             }
         }
     }
 
-    if (chosenPeer)
-        trigger(chosenPeer, TriggerReason::reply);
+    {
+        ScopedLockType sl(mLock);
+        for (auto const& [peer, count] : useful)
+            updateWindow(peer, count);
+    }
+
+    // Keep a request outstanding with every peer that is sending us
+    // useful data, rather than only the best one. Ask the most useful
+    // peers first, breaking ties in favor of the peer that responded
+    // first, so they get the nodes nobody has been asked for yet.
+    std::stable_sort(
+        useful.begin(), useful.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.second > rhs.second;
+        });
+    for (auto const& [peer, count] : useful)
+    {
+        if (count < 0 || (count == 0 && peer != useful.front().first))
+            break;
+        trigger(peer, TriggerReason::reply);
+    }
 }
 
 Json::Value
@@ -17,12 +17,18 @@
 */
 //==============================================================================
 
+#include <ripple/app/ledger/BuildLedger.h>
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerCleaner.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/LedgerReplay.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/protocol/jss.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 namespace ripple {
 namespace detail {
@@ -39,6 +45,11 @@ Cleans up the ledger. Specifically, resolves these issues:
 
 2. Upon request, checks for missing nodes in a ledger and triggers a fetch.
 
+3. Upon request, replays the transactions of ledgers against their parents
+   and reports ledgers the replay doesn't reproduce. Several ledgers are
+   replayed at once. With a standalone server this checks the history in
+   the node store without connecting to the network.
+
 */
 
 class LedgerCleanerImp : public LedgerCleaner
@@ -67,9 +78,19 @@ class LedgerCleanerImp : public LedgerCleaner
     // Rewrite SQL databases
     bool fixTxns_ = false;
 
+    // Replay ledgers and check the results match
+    bool replay_ = false;
+
     // Number of errors encountered since last success
     int failures_ = 0;
 
+    // Number of ledgers whose replay didn't match
+    int mismatches_ = 0;
+
+    // Number of ledgers to replay at once
+    std::size_t const replayWorkers_ =
+        std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+
     //--------------------------------------------------------------------------
 public:
     LedgerCleanerImp(
@@ -135,8 +156,11 @@ public:
             map["max_ledger"] = maxRange_;
             map["check_nodes"] = checkNodes_ ? "true" : "false";
             map["fix_txns"] = fixTxns_ ? "true" : "false";
+            map["replay"] = replay_ ? "true" : "false";
             if (failures_ > 0)
                 map["fail_counts"] = failures_;
+            if (mismatches_ > 0)
+                map["replay_mismatches"] = mismatches_;
         }
     }
 
@@ -160,7 +184,9 @@ public:
             minRange_ = minRange;
             checkNodes_ = false;
             fixTxns_ = false;
+            replay_ = false;
             failures_ = 0;
+            mismatches_ = 0;
 
             /*
             JSON Parameters:
@@ -187,6 +213,11 @@ public:
                 "check_nodes"
                     A boolean, when set to true means check the nodes.
 
+                "replay"
+                    A boolean, when set to true means replay the transactions
+                    of each ledger against its parent and check the result
+                    matches the ledger.
+
                 "stop"
                     A boolean, when true informs the cleaner to gracefully
                     stop its current activities if any cleaning is taking place.
@@ -216,6 +247,9 @@ public:
             if (params.isMember(jss::check_nodes))
                 checkNodes_ = params[jss::check_nodes].asBool();
 
+            if (params.isMember(jss::replay))
+                replay_ = params[jss::replay].asBool();
+
             if (params.isMember(jss::stop) && params[jss::stop].asBool())
                 minRange_ = maxRange_ = 0;
 
@@ -346,6 +380,97 @@ private:
         return true;
     }
 
+    /** Replay a single ledger
+        @param ledgerIndex The index of the ledger to replay.
+        @param ledgerHash  The known correct hash of the ledger.
+        @return `false` if the replay didn't reproduce the ledger.
+    */
+    bool
+    doReplay(LedgerIndex const& ledgerIndex, LedgerHash const& ledgerHash)
+    {
+        auto& ledgerMaster = app_.getLedgerMaster();
+        auto const ledger = ledgerMaster.getLedgerByHash(ledgerHash);
+        auto const parent = ledger
+            ? ledgerMaster.getLedgerByHash(ledger->info().parentHash)
+            : nullptr;
+        if (!parent)
+        {
+            JLOG(j_.info()) << "Ledger " << ledgerIndex
+                            << " not available to replay";
+            return true;
+        }
+
+        try
+        {
+            auto const built =
+                verifyReplay(LedgerReplay(parent, ledger), app_, j_);
+            if (built->info().hash == ledgerHash)
+                return true;
+
+            JLOG(j_.warn()) << "Replay of ledger " << ledgerIndex
+                            << " mismatches: built " << built->info().hash
+                            << " expected " << ledgerHash;
+        }
+        catch (std::exception const& e)
+        {
+            JLOG(j_.warn()) << "Replay of ledger " << ledgerIndex
+                            << " failed: " << e.what();
+        }
+        return false;
+    }
+
+    /** Replay several ledgers at once
+        The cleaner's thread and up to replayWorkers_ - 1 jobs take the
+        ledgers in turn; this returns once they are all replayed.
+        @param ledgers The index and known correct hash of each ledger.
+    */
+    void
+    doReplays(std::vector<std::pair<LedgerIndex, LedgerHash>> const& ledgers)
+    {
+        std::atomic<std::size_t> next{0};
+        std::atomic<int> mismatches{0};
+
+        auto const work = [&]() {
+            for (auto i = next++; i < ledgers.size(); i = next++)
+            {
+                if (!doReplay(ledgers[i].first, ledgers[i].second))
+                    ++mismatches;
+            }
+        };
+
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t pending = 0;
+        for (std::size_t i = 1; i < std::min(ledgers.size(), replayWorkers_);
+             ++i)
+        {
+            {
+                std::lock_guard lock(mutex);
+                ++pending;
+            }
+            if (!app_.getJobQueue().addJob(
+                    jtREPLAY, "LedgerCleaner::replay", [&](Job&) {
+                        work();
+                        std::lock_guard lock(mutex);
+                        if (--pending == 0)
+                            done.notify_one();
+                    }))
+            {
+                std::lock_guard lock(mutex);
+                --pending;
+                break;
+            }
+        }
+        work();
+        {
+            std::unique_lock lock(mutex);
+            done.wait(lock, [&pending] { return pending == 0; });
+        }
+
+        std::lock_guard lock(mutex_);
+        mismatches_ += mismatches;
+    }
+
     /** Returns the hash of the specified ledger.
         @param ledgerIndex The index of the desired ledger.
         @param referenceLedger [out] An optional known good subsequent ledger.
@@ -411,12 +536,16 @@ private:
 
         std::shared_ptr<ReadView const> goodLedger;
 
+        // Cleaned ledgers waiting to be replayed
+        std::vector<std::pair<LedgerIndex, LedgerHash>> replays;
+
         while (!shouldExit())
         {
             LedgerIndex ledgerIndex;
             LedgerHash ledgerHash;
             bool doNodes;
             bool doTxns;
+            bool replay;
 
             while (app_.getFeeTrack().isLoadedLocal())
             {
@@ -438,6 +567,7 @@ private:
                 ledgerIndex = maxRange_;
                 doNodes = checkNodes_;
                 doTxns = fixTxns_;
+                replay = replay_;
             }
 
             ledgerHash = getHash(ledgerIndex, goodLedger);
@@ -466,6 +596,7 @@ private:
             }
             else
             {
+                bool last;
                 {
                     std::lock_guard lock(mutex_);
                     if (ledgerIndex == minRange_)
@@ -473,8 +604,20 @@ private:
                     if (ledgerIndex == maxRange_)
                         --maxRange_;
                     failures_ = 0;
+                    last = minRange_ > maxRange_;
                 }
-                // Reduce I/O pressure and wait for acquiring to catch up to us
+
+                if (replay)
+                {
+                    replays.emplace_back(ledgerIndex, ledgerHash);
+                    if (last || replays.size() >= 4 * replayWorkers_)
+                    {
+                        doReplays(replays);
+                        replays.clear();
+                    }
+                }
+
+                // Reduce I/O pressure and wait for acquiring to catch up
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
         }
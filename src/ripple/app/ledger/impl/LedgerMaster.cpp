@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/consensus/RCLValidations.h>
+#include <ripple/app/ledger/InboundLedger.h>
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/OpenLedger.h>
@@ -200,6 +201,9 @@ LedgerMaster::LedgerMaster(
           app_.journal("TaggedCache"))
     , m_stats(std::bind(&LedgerMaster::collect_metrics, this), collector)
 {
+    if (auto const ledgers = app_.config().STATE_DELTA_LOG)
+        stateDeltas_ = std::make_shared<StateDeltaLog>(
+            ledgers, app_.journal("StateDeltaLog"));
 }
 
 LedgerIndex
@@ -799,8 +803,25 @@ LedgerMaster::getFetchPack(LedgerIndex missing, InboundLedger::Reason reason)
         tmBH.set_query(true);
         tmBH.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
         tmBH.set_ledgerhash(haveHash->begin(), 32);
+        tmBH.set_delta(true);
         auto packet = std::make_shared<Message>(tmBH, protocol::mtGET_OBJECTS);
 
+        {
+            // Only this peer's reply to this request is accepted
+            using namespace std::chrono_literals;
+            auto const now = UptimeClock::now();
+            std::lock_guard lock(fetch_pack_deltas_mutex_);
+            for (auto it = fetch_pack_deltas_.begin();
+                 it != fetch_pack_deltas_.end();)
+            {
+                if (it->second.second + 30s < now)
+                    it = fetch_pack_deltas_.erase(it);
+                else
+                    ++it;
+            }
+            fetch_pack_deltas_[*haveHash] = {target->id(), now};
+        }
+
         target->send(packet);
         JLOG(m_journal.trace()) << "Requested fetch pack for " << missing;
     }
@@ -1996,6 +2017,8 @@ LedgerMaster::doAdvance(std::unique_lock<std::recursive_mutex>& sl)
                 {
                     ScopedUnlock sul{sl};
                     app_.getOPs().pubLedger(ledger);
+                    if (stateDeltas_)
+                        stateDeltas_->append(ledger);
                 }
             }
 
@@ -2013,6 +2036,181 @@ LedgerMaster::addFetchPack(uint256 const& hash, std::shared_ptr<Blob> data)
     fetch_packs_.canonicalize_replace_client(hash, data);
 }
 
+bool
+LedgerMaster::takeFetchPackDelta(uint256 const& hash, Peer::id_t peer)
+{
+    std::lock_guard lock(fetch_pack_deltas_mutex_);
+    auto const it = fetch_pack_deltas_.find(hash);
+    if (it == fetch_pack_deltas_.end() || it->second.first != peer)
+        return false;
+    fetch_pack_deltas_.erase(it);
+    return true;
+}
+
+void
+LedgerMaster::addFetchPackDelta(
+    std::weak_ptr<Peer> const& wPeer,
+    std::shared_ptr<protocol::TMGetObjectByHash> const& packet)
+{
+    auto const isKey = [](std::string const& s) {
+        return s.size() == uint256::bytes;
+    };
+
+    auto const charge = [&wPeer]() {
+        if (auto const peer = wPeer.lock())
+            peer->charge(Resource::feeBadData);
+    };
+
+    if (!isKey(packet->ledgerhash()))
+        return;
+
+    auto const have = getLedgerByHash(uint256{packet->ledgerhash()});
+    if (!have)
+    {
+        JLOG(m_journal.debug()) << "Fetch pack delta for unknown ledger";
+        return;
+    }
+
+    // The pack holds ledgers in reverse order, each one the parent of the
+    // one before it. The state of each is rebuilt from the state of the
+    // ledger before it.
+    std::shared_ptr<SHAMap const> base = have->stateMap().snapShot(false);
+    uint256 expected = have->info().parentHash;
+    std::shared_ptr<SHAMap> state;
+    LedgerInfo info;
+
+    // The entries of a ledger we already have are skipped
+    bool skip = false;
+
+    // Check the rebuilt state against its header and add its new nodes
+    auto const finish = [&]() {
+        if (!state)
+            return true;
+
+        if (state->getHash().as_uint256() != info.accountHash)
+        {
+            JLOG(m_journal.warn())
+                << "Fetch pack delta doesn't match ledger " << info.seq;
+            return false;
+        }
+
+        state->setImmutable();
+        state->visitDifferences(
+            base.get(), [this](SHAMapAbstractNode& node) -> bool {
+                Serializer s;
+                node.addRaw(s, snfPREFIX);
+                addFetchPack(
+                    node.getNodeHash().as_uint256(),
+                    std::make_shared<Blob>(s.peekData()));
+                return true;
+            });
+
+        base = std::move(state);
+        return true;
+    };
+
+    std::uint32_t seq = 0;
+    bool progress = false;
+    try
+    {
+        for (auto const& obj : packet->objects())
+        {
+            if (obj.has_index())
+            {
+                // A state entry of the ledger being rebuilt
+                if (skip)
+                    continue;
+
+                if (!state || !isKey(obj.index()))
+                {
+                    charge();
+                    return;
+                }
+
+                uint256 const key{obj.index()};
+                bool ok;
+                if (!obj.has_data())
+                    ok = state->delItem(key);
+                else
+                {
+                    auto item = std::make_shared<SHAMapItem const>(
+                        key, Blob(obj.data().begin(), obj.data().end()));
+                    ok = state->hasItem(key)
+                        ? state->updateGiveItem(std::move(item), false, false)
+                        : state->addGiveItem(std::move(item), false, false);
+                }
+
+                if (!ok)
+                {
+                    JLOG(m_journal.warn()) << "Bad fetch pack delta entry";
+                    charge();
+                    return;
+                }
+            }
+            else if (obj.has_hash() && isKey(obj.hash()))
+            {
+                uint256 const hash{obj.hash()};
+
+                if (hash == expected)
+                {
+                    // The header of the next ledger
+                    auto data = std::make_shared<Blob>(
+                        obj.data().begin(), obj.data().end());
+                    if (!finish() || hash != sha512Half(makeSlice(*data)))
+                    {
+                        charge();
+                        return;
+                    }
+
+                    info = deserializePrefixedHeader(makeSlice(*data));
+                    expected = info.parentHash;
+                    seq = info.seq;
+
+                    std::shared_ptr<Ledger const> known;
+                    if (haveLedger(info.seq))
+                        known = getLedgerByHash(hash);
+
+                    skip = static_cast<bool>(known);
+                    if (skip)
+                    {
+                        JLOG(m_journal.debug())
+                            << "Late fetch pack delta for " << info.seq;
+                        base = known->stateMap().snapShot(false);
+                        continue;
+                    }
+
+                    progress = true;
+                    state = base->snapShot(true);
+                    state->setLedgerSeq(info.seq);
+                    addFetchPack(hash, std::move(data));
+                }
+                else if (!skip)
+                {
+                    // Transaction nodes are sent as they are
+                    addFetchPack(
+                        hash,
+                        std::make_shared<Blob>(
+                            obj.data().begin(), obj.data().end()));
+                }
+            }
+        }
+
+        if (!finish())
+        {
+            charge();
+            return;
+        }
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(m_journal.warn()) << "Exception adding fetch pack delta: "
+                               << e.what();
+        return;
+    }
+
+    gotFetchPack(progress, seq);
+}
+
 boost::optional<Blob>
 LedgerMaster::getFetchPack(uint256 const& hash)
 {
@@ -2100,6 +2298,38 @@ LedgerMaster::makeFetchPack(
         return;
     }
 
+    try
+    {
+        protocol::TMGetObjectByHash reply;
+        buildFetchPack(
+            *request,
+            std::move(haveLedger),
+            std::move(wantLedger),
+            reply,
+            uptime);
+
+        JLOG(m_journal.info())
+            << "Built fetch pack with " << reply.objects().size() << " nodes";
+        auto msg = std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
+        peer->send(msg);
+    }
+    catch (std::exception const&)
+    {
+        JLOG(m_journal.warn()) << "Exception building fetch pach";
+    }
+}
+
+void
+LedgerMaster::buildFetchPack(
+    protocol::TMGetObjectByHash const& request,
+    std::shared_ptr<Ledger const> haveLedger,
+    std::shared_ptr<Ledger const> wantLedger,
+    protocol::TMGetObjectByHash& reply,
+    UptimeClock::time_point uptime,
+    int deltaLimit)
+{
+    using namespace std::chrono_literals;
+
     auto fpAppender = [](protocol::TMGetObjectByHash* reply,
                          std::uint32_t ledgerSeq,
                          SHAMapHash const& hash,
@@ -2110,38 +2340,63 @@ LedgerMaster::makeFetchPack(
         newObj.set_data(&blob[0], blob.size());
     };
 
-    try
+    reply.set_query(false);
+
+    if (request.has_seq())
+        reply.set_seq(request.seq());
+
+    reply.set_ledgerhash(request.ledgerhash());
+    reply.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+
+    bool delta = request.has_delta() && request.delta();
+
+    // Building a fetch pack:
+    //  1. Add the header for the requested ledger.
+    //  2. Add the nodes for the AccountStateMap of that ledger or,
+    //     if the peer asked for a delta, the entries that differ
+    //     from the ledger after it.
+    //  3. If there are transactions, add the nodes for the
+    //     transactions of the ledger.
+    //  4. If the FetchPack now contains greater than or equal to
+    //     256 entries then stop.
+    //  5. If not very much time has elapsed, then loop back and repeat
+    //     the same process adding the previous ledger to the FetchPack.
+    do
     {
-        protocol::TMGetObjectByHash reply;
-        reply.set_query(false);
-
-        if (request->has_seq())
-            reply.set_seq(request->seq());
-
-        reply.set_ledgerhash(request->ledgerhash());
-        reply.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
-
-        // Building a fetch pack:
-        //  1. Add the header for the requested ledger.
-        //  2. Add the nodes for the AccountStateMap of that ledger.
-        //  3. If there are transactions, add the nodes for the
-        //     transactions of the ledger.
-        //  4. If the FetchPack now contains greater than or equal to
-        //     256 entries then stop.
-        //  5. If not very much time has elapsed, then loop back and repeat
-        //     the same process adding the previous ledger to the FetchPack.
-        do
+        std::uint32_t lSeq = wantLedger->info().seq;
+
+        SHAMap::Delta changes;
+        if (delta &&
+            !wantLedger->stateMap().compare(
+                haveLedger->stateMap(), changes, deltaLimit))
         {
-            std::uint32_t lSeq = wantLedger->info().seq;
+            // Too many changes to send as a delta
+            if (reply.objects_size() != 0)
+                break;
+            delta = false;
+        }
 
-            protocol::TMIndexedObject& newObj = *reply.add_objects();
-            newObj.set_hash(wantLedger->info().hash.data(), 256 / 8);
-            Serializer s(256);
-            s.add32(HashPrefix::ledgerMaster);
-            addRaw(wantLedger->info(), s);
-            newObj.set_data(s.getDataPtr(), s.getLength());
-            newObj.set_ledgerseq(lSeq);
+        protocol::TMIndexedObject& newObj = *reply.add_objects();
+        newObj.set_hash(wantLedger->info().hash.data(), 256 / 8);
+        Serializer s(256);
+        s.add32(HashPrefix::ledgerMaster);
+        addRaw(wantLedger->info(), s);
+        newObj.set_data(s.getDataPtr(), s.getLength());
+        newObj.set_ledgerseq(lSeq);
 
+        if (delta)
+        {
+            for (auto const& [key, items] : changes)
+            {
+                protocol::TMIndexedObject& entry = *reply.add_objects();
+                entry.set_index(key.data(), 256 / 8);
+                entry.set_ledgerseq(lSeq);
+                if (auto const& item = items.first)
+                    entry.set_data(item->data(), item->size());
+            }
+        }
+        else
+        {
             wantLedger->stateMap().getFetchPack(
                 &haveLedger->stateMap(),
                 true,
@@ -2152,36 +2407,30 @@ LedgerMaster::makeFetchPack(
                     lSeq,
                     std::placeholders::_1,
                     std::placeholders::_2));
+        }
 
-            if (wantLedger->info().txHash.isNonZero())
-                wantLedger->txMap().getFetchPack(
-                    nullptr,
-                    true,
-                    512,
-                    std::bind(
-                        fpAppender,
-                        &reply,
-                        lSeq,
-                        std::placeholders::_1,
-                        std::placeholders::_2));
-
-            if (reply.objects().size() >= 512)
-                break;
+        if (wantLedger->info().txHash.isNonZero())
+            wantLedger->txMap().getFetchPack(
+                nullptr,
+                true,
+                512,
+                std::bind(
+                    fpAppender,
+                    &reply,
+                    lSeq,
+                    std::placeholders::_1,
+                    std::placeholders::_2));
 
-            // move may save a ref/unref
-            haveLedger = std::move(wantLedger);
-            wantLedger = getLedgerByHash(haveLedger->info().parentHash);
-        } while (wantLedger && UptimeClock::now() <= uptime + 1s);
+        if (reply.objects().size() >= 512)
+            break;
 
-        JLOG(m_journal.info())
-            << "Built fetch pack with " << reply.objects().size() << " nodes";
-        auto msg = std::make_shared<Message>(reply, protocol::mtGET_OBJECTS);
-        peer->send(msg);
-    }
-    catch (std::exception const&)
-    {
-        JLOG(m_journal.warn()) << "Exception building fetch pach";
-    }
+        // move may save a ref/unref
+        haveLedger = std::move(wantLedger);
+        wantLedger = getLedgerByHash(haveLedger->info().parentHash);
+    } while (wantLedger && UptimeClock::now() <= uptime + 1s);
+
+    if (delta)
+        reply.set_delta(true);
 }
 
 std::size_t
@@ -23,9 +23,7 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/tx/apply.h>
 #include <ripple/ledger/CachedView.h>
-#include <ripple/overlay/Message.h>
 #include <ripple/overlay/Overlay.h>
-#include <ripple/overlay/predicates.h>
 #include <ripple/protocol/Feature.h>
 #include <boost/range/adaptor/transformed.hpp>
 
@@ -136,9 +134,15 @@ OpenLedger::accept(
     // Call the modifier
     if (f)
         f(*next, j_);
-    // Apply local tx
+    // Apply local tx. Most of them were carried over from the
+    // previous open view or made it into the closed ledger.
     for (auto const& item : locals)
+    {
+        auto const txId = item.second->getTransactionID();
+        if (ledger->txExists(txId) || next->txExists(txId))
+            continue;
         app.getTxQ().apply(app, *next, item.second, flags, j_);
+    }
 
     // If we didn't relay this transaction recently, relay it to all peers
     for (auto const& txpair : next->txs)
@@ -156,9 +160,7 @@ OpenLedger::accept(
             msg.set_status(protocol::tsNEW);
             msg.set_receivetimestamp(
                 app.timeKeeper().now().time_since_epoch().count());
-            app.overlay().foreach(send_if_not(
-                std::make_shared<Message>(msg, protocol::mtTRANSACTION),
-                peer_in_set(*toSkip)));
+            app.overlay().relay(txId, msg, *toSkip);
         }
     }
 
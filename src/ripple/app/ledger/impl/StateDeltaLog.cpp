@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/ledger/StateDeltaLog.h>
+#include <ripple/basics/Log.h>
+#include <ripple/shamap/SHAMapMissingNode.h>
+#include <algorithm>
+#include <cassert>
+
+namespace ripple {
+
+// A ledger that changes more entries than this restarts the log
+static int constexpr maxChanges = 100000;
+
+StateDeltaLog::StateDeltaLog(std::uint32_t ledgers, beast::Journal journal)
+    : size_(ledgers), j_(journal)
+{
+    assert(size_ != 0);
+}
+
+void
+StateDeltaLog::append(std::shared_ptr<Ledger const> const& ledger)
+{
+    std::shared_ptr<Ledger const> parent;
+    {
+        std::unique_lock lock(mutex_);
+        parent = std::move(last_);
+        last_ = ledger;
+    }
+
+    auto const& info = ledger->info();
+
+    // Both maps are immutable, so they can be compared without the lock
+    SHAMap::Delta delta;
+    bool linked = parent && (parent->info().seq + 1 == info.seq) &&
+        (parent->info().hash == info.parentHash);
+    if (linked)
+    {
+        try
+        {
+            linked = ledger->stateMap().compare(
+                parent->stateMap(), delta, maxChanges);
+        }
+        catch (SHAMapMissingNode const& e)
+        {
+            JLOG(j_.debug()) << "Can't log ledger " << info.seq << ": "
+                             << e.what();
+            linked = false;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+
+    if (!linked)
+    {
+        // Nothing retained can be carried forward: entries the new ledger
+        // doesn't show as changed may have changed in between.
+        JLOG(j_.debug()) << "Restarting state delta log at " << info.seq;
+        ledgers_.clear();
+        items_.clear();
+        return;
+    }
+
+    Changes changes{info.seq, info.hash, {}};
+    changes.keys.reserve(delta.size());
+    for (auto const& [key, items] : delta)
+    {
+        changes.keys.push_back(key);
+        items_[key].emplace_back(info.seq, items.first);
+    }
+    ledgers_.push_back(std::move(changes));
+
+    while (ledgers_.size() > size_)
+    {
+        auto const& oldest = ledgers_.front();
+        for (auto const& key : oldest.keys)
+        {
+            auto iter = items_.find(key);
+            assert(iter != items_.end());
+            auto& history = iter->second;
+            assert(history.front().first == oldest.seq);
+            if (history.size() == 1)
+                items_.erase(iter);
+            else
+                history.erase(history.begin());
+        }
+        ledgers_.pop_front();
+    }
+}
+
+boost::optional<std::shared_ptr<SHAMapItem const>>
+StateDeltaLog::lookup(
+    LedgerIndex seq,
+    uint256 const& hash,
+    uint256 const& key) const
+{
+    std::shared_lock lock(mutex_);
+
+    if (ledgers_.empty() || seq < ledgers_.front().seq ||
+        seq > ledgers_.back().seq)
+        return boost::none;
+
+    // Only answer for the ledger the log followed
+    if (ledgers_[seq - ledgers_.front().seq].hash != hash)
+        return boost::none;
+
+    auto const iter = items_.find(key);
+    if (iter == items_.end())
+        return boost::none;
+
+    // Find the last change at or before the requested ledger
+    auto const& history = iter->second;
+    auto const change = std::upper_bound(
+        history.begin(),
+        history.end(),
+        seq,
+        [](LedgerIndex s, auto const& entry) { return s < entry.first; });
+    if (change == history.begin())
+        return boost::none;
+
+    return std::prev(change)->second;
+}
+
+boost::optional<std::pair<LedgerIndex, LedgerIndex>>
+StateDeltaLog::range() const
+{
+    std::shared_lock lock(mutex_);
+    if (ledgers_.empty())
+        return boost::none;
+    return std::make_pair(ledgers_.front().seq, ledgers_.back().seq);
+}
+
+}  // namespace ripple
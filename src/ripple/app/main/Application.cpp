@@ -1730,6 +1730,7 @@ ApplicationImp::startGenesisLedger()
 
     std::shared_ptr<Ledger> const genesis = std::make_shared<Ledger>(
         create_genesis, *config_, initialAmendments, nodeFamily_);
+    genesis->setStateDeltas(m_ledgerMaster->getStateDeltas());
     m_ledgerMaster->storeLedger(genesis);
 
     auto const next =
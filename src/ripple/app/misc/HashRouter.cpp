@@ -68,6 +68,16 @@ HashRouter::addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags)
     return created;
 }
 
+std::pair<bool, boost::optional<Stopwatch::time_point>>
+HashRouter::addSuppressionPeerWithStatus(uint256 const& key, PeerShortID peer)
+{
+    std::lock_guard lock(mutex_);
+
+    auto [s, created] = emplace(key);
+    s.addPeer(peer);
+    return {created, s.relayed()};
+}
+
 bool
 HashRouter::shouldProcess(
     uint256 const& key,
@@ -84,6 +94,15 @@ HashRouter::shouldProcess(
     return s.shouldProcess(suppressionMap_.clock().now(), tx_interval);
 }
 
+bool
+HashRouter::shouldRequest(uint256 const& key, std::chrono::seconds interval)
+{
+    std::lock_guard lock(mutex_);
+
+    return emplace(key).first.shouldRequest(
+        suppressionMap_.clock().now(), interval);
+}
+
 int
 HashRouter::getFlags(uint256 const& key)
 {
@@ -97,6 +97,13 @@ private:
             return std::move(peers_);
         }
 
+        /** Return when this item was last relayed, if it was */
+        boost::optional<Stopwatch::time_point>
+        relayed() const
+        {
+            return relayed_;
+        }
+
         /** Determines if this item should be relayed.
 
             Checks whether the item has been recently relayed.
@@ -137,6 +144,15 @@ private:
             return true;
         }
 
+        bool
+        shouldRequest(Stopwatch::time_point now, std::chrono::seconds interval)
+        {
+            if (requested_ && ((*requested_ + interval) > now))
+                return false;
+            requested_.emplace(now);
+            return true;
+        }
+
     private:
         int flags_ = 0;
         std::set<PeerShortID> peers_;
@@ -144,6 +160,7 @@ private:
         // than one flag needs to expire independently.
         boost::optional<Stopwatch::time_point> relayed_;
         boost::optional<Stopwatch::time_point> processed_;
+        boost::optional<Stopwatch::time_point> requested_;
         std::uint32_t recoveries_ = 0;
     };
 
@@ -188,6 +205,14 @@ public:
     bool
     addSuppressionPeer(uint256 const& key, PeerShortID peer, int& flags);
 
+    /** Add a suppression peer and get the item's relay status.
+
+        @return Whether the item is new, and when it was last relayed,
+                if it was.
+    */
+    std::pair<bool, boost::optional<Stopwatch::time_point>>
+    addSuppressionPeerWithStatus(uint256 const& key, PeerShortID peer);
+
     // Add a peer suppression and return whether the entry should be processed
     bool
     shouldProcess(
@@ -196,6 +221,14 @@ public:
         int& flags,
         std::chrono::seconds tx_interval);
 
+    /** Determines whether the item should be requested from a peer.
+
+        Returns false if it was requested less than `interval` ago, so
+        that an item is asked for again if the peer never answers.
+    */
+    bool
+    shouldRequest(uint256 const& key, std::chrono::seconds interval);
+
     /** Set the flags on a hash.
 
         @return `true` if the flags were changed. `false` if unchanged.
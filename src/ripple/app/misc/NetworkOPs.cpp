@@ -83,6 +83,8 @@ class NetworkOPsImp final : public NetworkOPs
         bool const admin;
         bool const local;
         FailHard const failType;
+        // Preflight run before the transaction was queued, if any
+        boost::optional<PreflightResult> const pfresult;
         bool applied = false;
         TER result;
 
@@ -90,11 +92,29 @@ class NetworkOPsImp final : public NetworkOPs
             std::shared_ptr<Transaction> t,
             bool a,
             bool l,
-            FailHard f)
-            : transaction(t), admin(a), local(l), failType(f)
+            FailHard f,
+            boost::optional<PreflightResult> pf = boost::none)
+            : transaction(t)
+            , admin(a)
+            , local(l)
+            , failType(f)
+            , pfresult(std::move(pf))
         {
             assert(local || failType == FailHard::no);
         }
+
+        static ApplyFlags
+        applyFlags(bool admin, FailHard failType)
+        {
+            ApplyFlags flags = tapNONE;
+            if (admin)
+                flags |= tapUNLIMITED;
+
+            if (failType == FailHard::yes)
+                flags |= tapFAIL_HARD;
+
+            return flags;
+        }
     };
 
     /**
@@ -298,12 +318,14 @@ public:
      * @param transaction Transaction object.
      * @param bUnliimited Whether a privileged client connection submitted it.
      * @param failType fail_hard setting from transaction submission.
+     * @param pfresult Result of preflight, run before the batch is locked.
      */
     void
     doTransactionSync(
         std::shared_ptr<Transaction> transaction,
         bool bUnlimited,
-        FailHard failType);
+        FailHard failType,
+        PreflightResult const& pfresult);
 
     /**
      * For transactions not submitted by a locally connected client, fire and
@@ -313,12 +335,14 @@ public:
      * @param transaction Transaction object
      * @param bUnlimited Whether a privileged client connection submitted it.
      * @param failType fail_hard setting from transaction submission.
+     * @param pfresult Result of preflight, run before the batch is locked.
      */
     void
     doTransactionAsync(
         std::shared_ptr<Transaction> transaction,
         bool bUnlimited,
-        FailHard failtype);
+        FailHard failtype,
+        PreflightResult const& pfresult);
 
     /**
      * Apply transactions in batches. Continue until none are queued.
@@ -685,15 +709,32 @@ private:
         bool bValidated,
         std::shared_ptr<ReadView const> const& lpCurrent);
 
+    /** The binary form of a published transaction.
+
+        The transaction and its metadata are sent as hex blobs, exactly as
+        stored in the ledger, along with the fields needed to place them.
+    */
+    Json::Value
+    transBinary(
+        AcceptedLedgerTx const& alTx,
+        bool bValidated,
+        std::shared_ptr<ReadView const> const& lpCurrent);
+
     void
     pubValidatedTransaction(
         std::shared_ptr<ReadView const> const& alAccepted,
         const AcceptedLedgerTx& alTransaction);
+    /** Publish a transaction to the account streams.
+
+        @param msg the transaction as published to the other streams;
+                   pubValidatedTransaction and pubProposedTransaction build
+                   it once and share it with the account subscribers.
+    */
     void
     pubAccountTransaction(
-        std::shared_ptr<ReadView const> const& lpCurrent,
         const AcceptedLedgerTx& alTransaction,
-        bool isAccepted);
+        bool isAccepted,
+        PublishedJson& msg);
 
     void
     pubServer();
@@ -1219,40 +1260,37 @@ NetworkOPsImp::processTransaction(
     // canonicalize can change our pointer
     app_.getMasterTransaction().canonicalize(&transaction);
 
+    // The stateless checks don't need the open ledger. Run them here, on
+    // this job's thread, so that only the stateful part of applying the
+    // transaction is done while the batch holds the master lock.
+    auto const pfresult = preflight(
+        app_,
+        view->rules(),
+        *transaction->getSTransaction(),
+        TransactionStatus::applyFlags(bUnlimited, failType),
+        app_.journal("OpenLedger"));
 
     if (bLocal)
-        doTransactionSync(transaction, bUnlimited, failType);
-    else 
-        doTransactionAsync(transaction, bUnlimited, failType);
+        doTransactionSync(transaction, bUnlimited, failType, pfresult);
+    else
+        doTransactionAsync(transaction, bUnlimited, failType, pfresult);
 }
 
 void
 NetworkOPsImp::doTransactionAsync(
     std::shared_ptr<Transaction> transaction,
     bool bUnlimited,
-    FailHard failType)
+    FailHard failType,
+    PreflightResult const& pfresult)
 {
+    // Emitted transactions were already screened out by processTransaction
     std::lock_guard lock(mMutex);
-    
-    auto const view = m_ledgerMaster.getCurrentLedger();
-
-    // Enforce Network bar for emitted txn
-    if (view->rules().enabled(featureHooks) && 
-        hook::isEmittedTxn(*transaction->getSTransaction()))
-    {
-        JLOG(m_journal.info())
-            << "Transaction received over network has EmitDetails, discarding.";
-        //RH NOTE: cannot set SF_BAD because if the tx will be generated by a hook we are about to execute
-        //then this would poison consensus for that emitted tx
-        //RH TODO: (severely) charge peer who sent
-        return;
-    }
 
     if (transaction->getApplying())
         return;
 
     mTransactions.push_back(
-        TransactionStatus(transaction, bUnlimited, false, failType));
+        TransactionStatus(transaction, bUnlimited, false, failType, pfresult));
     transaction->setApplying();
 
     if (mDispatchState == DispatchState::none)
@@ -1270,28 +1308,16 @@ void
 NetworkOPsImp::doTransactionSync(
     std::shared_ptr<Transaction> transaction,
     bool bUnlimited,
-    FailHard failType)
+    FailHard failType,
+    PreflightResult const& pfresult)
 {
+    // Emitted transactions were already screened out by processTransaction
     std::unique_lock<std::mutex> lock(mMutex);
 
-    auto const view = m_ledgerMaster.getCurrentLedger();
-
-    // Enforce Network bar for emitted txn
-    if (view->rules().enabled(featureHooks) && 
-        hook::isEmittedTxn(*transaction->getSTransaction()))
-    {
-        JLOG(m_journal.info())
-            << "Transaction received over network has EmitDetails, discarding.";
-        //RH NOTE: cannot set SF_BAD because if the tx will be generated by a hook we are about to execute
-        //then this would poison consensus for that emitted tx
-        //RH TODO: (severely) charge peer who sent
-        return;
-    }
-
     if (!transaction->getApplying())
     {
-        mTransactions.push_back(
-            TransactionStatus(transaction, bUnlimited, true, failType));
+        mTransactions.push_back(TransactionStatus(
+            transaction, bUnlimited, true, failType, pfresult));
         transaction->setApplying();
     }
 
@@ -1360,15 +1386,16 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                 for (TransactionStatus& e : transactions)
                 {
                     // we check before adding to the batch
-                    ApplyFlags flags = tapNONE;
-                    if (e.admin)
-                        flags |= tapUNLIMITED;
-
-                    if (e.failType == FailHard::yes)
-                        flags |= tapFAIL_HARD;
-
-                    auto const result = app_.getTxQ().apply(
-                        app_, view, e.transaction->getSTransaction(), flags, j);
+                    auto const& tx = e.transaction->getSTransaction();
+                    auto const result = e.pfresult
+                        ? app_.getTxQ().apply(app_, view, tx, *e.pfresult, j)
+                        : app_.getTxQ().apply(
+                              app_,
+                              view,
+                              tx,
+                              TransactionStatus::applyFlags(
+                                  e.admin, e.failType),
+                              j);
                     e.result = result.first;
                     e.applied = result.second;
                     changed = changed || result.second;
@@ -1504,9 +1531,8 @@ NetworkOPsImp::apply(std::unique_lock<std::mutex>& batchLock)
                         app_.timeKeeper().now().time_since_epoch().count());
                     tx.set_deferred(e.result == terQUEUED);
                     // FIXME: This should be when we received it
-                    app_.overlay().foreach(send_if_not(
-                        std::make_shared<Message>(tx, protocol::mtTRANSACTION),
-                        peer_in_set(*toSkip)));
+                    app_.overlay().relay(
+                        e.transaction->getID(), tx, *toSkip);
                     e.transaction->setBroadcast();
                 }
             }
@@ -1948,12 +1974,14 @@ NetworkOPsImp::pubManifest(Manifest const& mo)
             jvObj[jss::signature] = strHex(*sig);
         jvObj[jss::master_signature] = strHex(mo.getMasterSignature());
 
+        PublishedJson msg(jvObj);
+
         for (auto i = mStreamMaps[sManifests].begin();
              i != mStreamMaps[sManifests].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2051,6 +2079,8 @@ NetworkOPsImp::pubServer()
 
         mLastFeeSummary = f;
 
+        PublishedJson msg(jvObj);
+
         for (auto i = mStreamMaps[sServer].begin();
              i != mStreamMaps[sServer].end();)
         {
@@ -2061,7 +2091,7 @@ NetworkOPsImp::pubServer()
             //             sending of JSON data.
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2084,11 +2114,13 @@ NetworkOPsImp::pubConsensus(ConsensusPhase phase)
         jvObj[jss::type] = "consensusPhase";
         jvObj[jss::consensus] = to_string(phase);
 
+        PublishedJson msg(jvObj);
+
         for (auto i = streamMap.begin(); i != streamMap.end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2151,12 +2183,14 @@ NetworkOPsImp::pubValidation(std::shared_ptr<STValidation> const& val)
         if (auto const reserveInc = (*val)[~sfReserveIncrement])
             jvObj[jss::reserve_inc] = *reserveInc;
 
+        PublishedJson msg(jvObj);
+
         for (auto i = mStreamMaps[sValidations].begin();
              i != mStreamMaps[sValidations].end();)
         {
             if (auto p = i->second.lock())
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2178,6 +2212,8 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
         jvObj[jss::type] = "peerStatusChange";
 
+        PublishedJson msg(jvObj);
+
         for (auto i = mStreamMaps[sPeerStatus].begin();
              i != mStreamMaps[sPeerStatus].end();)
         {
@@ -2185,7 +2221,7 @@ NetworkOPsImp::pubPeerStatus(std::function<Json::Value(void)> const& func)
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++i;
             }
             else
@@ -2881,7 +2917,11 @@ NetworkOPsImp::pubProposedTransaction(
     std::shared_ptr<STTx const> const& stTxn,
     TER terResult)
 {
-    Json::Value jvObj = transJson(*stTxn, terResult, false, lpCurrent);
+    AcceptedLedgerTx alt(
+        lpCurrent, stTxn, terResult, app_.accountIDCache(), app_.logs());
+    PublishedJson msg(
+        [&] { return transJson(*stTxn, terResult, false, lpCurrent); },
+        [&] { return transBinary(alt, false, lpCurrent); });
 
     {
         std::lock_guard sl(mSubLock);
@@ -2893,7 +2933,7 @@ NetworkOPsImp::pubProposedTransaction(
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++it;
             }
             else
@@ -2902,10 +2942,8 @@ NetworkOPsImp::pubProposedTransaction(
             }
         }
     }
-    AcceptedLedgerTx alt(
-        lpCurrent, stTxn, terResult, app_.accountIDCache(), app_.logs());
     JLOG(m_journal.trace()) << "pubProposed: " << alt.getJson();
-    pubAccountTransaction(lpCurrent, alt, false);
+    pubAccountTransaction(alt, false, msg);
 }
 
 void
@@ -2952,13 +2990,15 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
                     app_.getLedgerMaster().getCompleteLedgers();
             }
 
+            PublishedJson msg(jvObj);
+
             auto it = mStreamMaps[sLedger].begin();
             while (it != mStreamMaps[sLedger].end())
             {
                 InfoSub::pointer p = it->second.lock();
                 if (p)
                 {
-                    p->send(jvObj, true);
+                    p->send(msg, true);
                     ++it;
                 }
                 else
@@ -2974,6 +3014,8 @@ NetworkOPsImp::pubLedger(std::shared_ptr<ReadView const> const& lpAccepted)
         JLOG(m_journal.trace()) << "pubAccepted: " << accTx->getJson();
         pubValidatedTransaction(lpAccepted, *accTx);
     }
+
+    app_.getOrderBookDB().follow(lpAccepted);
 }
 
 void
@@ -3063,20 +3105,73 @@ NetworkOPsImp::transJson(
     return jvObj;
 }
 
+Json::Value
+NetworkOPsImp::transBinary(
+    AcceptedLedgerTx const& alTx,
+    bool bValidated,
+    std::shared_ptr<ReadView const> const& lpCurrent)
+{
+    Json::Value jvObj(Json::objectValue);
+    std::string sToken;
+    std::string sHuman;
+
+    transResultInfo(alTx.getResult(), sToken, sHuman);
+
+    Serializer s;
+    alTx.getTxn()->add(s);
+
+    jvObj[jss::type] = "transaction";
+    jvObj[jss::tx_blob] = strHex(s.peekData());
+    jvObj[jss::hash] = to_string(alTx.getTransactionID());
+
+    if (bValidated)
+    {
+        jvObj[jss::ledger_index] = lpCurrent->info().seq;
+        jvObj[jss::ledger_hash] = to_string(lpCurrent->info().hash);
+        jvObj[jss::date] =
+            lpCurrent->info().closeTime.time_since_epoch().count();
+        jvObj[jss::validated] = true;
+    }
+    else
+    {
+        jvObj[jss::validated] = false;
+        jvObj[jss::ledger_current_index] = lpCurrent->info().seq;
+    }
+
+    if (alTx.isApplied())
+        jvObj[jss::meta] = strHex(alTx.getRawMeta());
+
+    jvObj[jss::status] = bValidated ? "closed" : "proposed";
+    jvObj[jss::engine_result] = sToken;
+    jvObj[jss::engine_result_code] = alTx.getResult();
+    jvObj[jss::engine_result_message] = sHuman;
+
+    return jvObj;
+}
+
 void
 NetworkOPsImp::pubValidatedTransaction(
     std::shared_ptr<ReadView const> const& alAccepted,
     const AcceptedLedgerTx& alTx)
 {
     std::shared_ptr<STTx const> stTxn = alTx.getTxn();
-    Json::Value jvObj = transJson(*stTxn, alTx.getResult(), true, alAccepted);
 
-    if (auto const txMeta = alTx.getMeta())
-    {
-        jvObj[jss::meta] = txMeta->getJson(JsonOptions::none);
-        RPC::insertDeliveredAmount(
-            jvObj[jss::meta], *alAccepted, stTxn, *txMeta);
-    }
+    // The same message goes to the transaction, book and account streams.
+    // Each form is only built if some subscriber asks for it.
+    PublishedJson msg(
+        [&] {
+            Json::Value jvObj =
+                transJson(*stTxn, alTx.getResult(), true, alAccepted);
+
+            if (auto const txMeta = alTx.getMeta())
+            {
+                jvObj[jss::meta] = txMeta->getJson(JsonOptions::none);
+                RPC::insertDeliveredAmount(
+                    jvObj[jss::meta], *alAccepted, stTxn, *txMeta);
+            }
+            return jvObj;
+        },
+        [&] { return transBinary(alTx, true, alAccepted); });
 
     {
         std::lock_guard sl(mSubLock);
@@ -3088,7 +3183,7 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++it;
             }
             else
@@ -3103,22 +3198,22 @@ NetworkOPsImp::pubValidatedTransaction(
 
             if (p)
             {
-                p->send(jvObj, true);
+                p->send(msg, true);
                 ++it;
             }
             else
                 it = mStreamMaps[sRTTransactions].erase(it);
         }
     }
-    app_.getOrderBookDB().processTxn(alAccepted, alTx, jvObj);
-    pubAccountTransaction(alAccepted, alTx, true);
+    app_.getOrderBookDB().processTxn(alAccepted, alTx, msg);
+    pubAccountTransaction(alTx, true, msg);
 }
 
 void
 NetworkOPsImp::pubAccountTransaction(
-    std::shared_ptr<ReadView const> const& lpCurrent,
     const AcceptedLedgerTx& alTx,
-    bool bAccepted)
+    bool bAccepted,
+    PublishedJson& msg)
 {
     hash_set<InfoSub::pointer> notify;
     int iProposed = 0;
@@ -3183,25 +3278,8 @@ NetworkOPsImp::pubAccountTransaction(
         << "pubAccountTransaction:"
         << " iProposed=" << iProposed << " iAccepted=" << iAccepted;
 
-    if (!notify.empty())
-    {
-        std::shared_ptr<STTx const> stTxn = alTx.getTxn();
-        Json::Value jvObj =
-            transJson(*stTxn, alTx.getResult(), bAccepted, lpCurrent);
-
-        if (alTx.isApplied())
-        {
-            if (auto const txMeta = alTx.getMeta())
-            {
-                jvObj[jss::meta] = txMeta->getJson(JsonOptions::none);
-                RPC::insertDeliveredAmount(
-                    jvObj[jss::meta], *lpCurrent, stTxn, *txMeta);
-            }
-        }
-
-        for (InfoSub::ref isrListener : notify)
-            isrListener->send(jvObj, true);
-    }
+    for (InfoSub::ref isrListener : notify)
+        isrListener->send(msg, true);
 }
 
 //
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/app/ledger/TransactionMaster.h>
+#include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/app/misc/SHAMapStoreImp.h>
 #include <ripple/beast/core/CurrentThreadName.h>
@@ -186,6 +187,8 @@ SHAMapStoreImp::SHAMapStoreImp(
     {
         // Configuration that affects the behavior of online delete
         get_if_exists(section, "delete_batch", deleteBatch_);
+        if (get_if_exists(section, "copy_threads", copyThreads_))
+            copyThreads_ = std::max(1u, std::min(copyThreads_, 16u));
         std::uint32_t temp;
         if (get_if_exists(section, "back_off_milliseconds", temp) ||
             // Included for backward compaibility with an undocumented setting
@@ -297,19 +300,115 @@ SHAMapStoreImp::fdRequired() const
 }
 
 bool
-SHAMapStoreImp::copyNode(
+SHAMapStoreImp::parallelCopy(
     std::uint64_t& nodeCount,
-    SHAMapAbstractNode const& node)
+    std::function<std::uint64_t(std::atomic<bool> const&)> const& task)
 {
-    // Copy a single record from node to dbRotating_
-    dbRotating_->fetch(node.getNodeHash().as_uint256(), node.getSeq());
-    if (!(++nodeCount % checkHealthInterval_))
+    std::atomic<bool> abort{false};
+    std::atomic<std::uint64_t> copied{0};
+    std::exception_ptr error;
+    std::uint32_t running = copyThreads_;
+    std::mutex mutex;
+    std::condition_variable done;
+
+    std::vector<std::thread> workers;
+    workers.reserve(copyThreads_);
+    for (std::uint32_t i = 0; i < copyThreads_; ++i)
     {
-        if (health())
-            return false;
+        workers.emplace_back([&] {
+            beast::setCurrentThreadName("SHAMapStore copy");
+            try
+            {
+                copied += task(abort);
+            }
+            catch (...)
+            {
+                abort = true;
+                std::lock_guard lock(mutex);
+                error = std::current_exception();
+            }
+
+            std::lock_guard lock(mutex);
+            if (--running == 0)
+                done.notify_one();
+        });
+    }
+
+    {
+        std::unique_lock lock(mutex);
+        while (!done.wait_for(
+            lock, std::chrono::seconds(1), [&] { return running == 0; }))
+        {
+            if (abort)
+                continue;
+
+            lock.unlock();
+            if (health())
+                abort = true;
+            lock.lock();
+        }
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    nodeCount += copied;
+    return abort;
+}
+
+bool
+SHAMapStoreImp::copyBackOff(
+    std::uint64_t nodeCount,
+    std::atomic<bool> const& abort)
+{
+    if (nodeCount % checkHealthInterval_)
+        return !abort;
+
+    // Rotation is not urgent, so give way to the live node while it is busy
+    while (!abort &&
+           (app_.getFeeTrack().isLoadedLocal() ||
+            app_.getJobQueue().isOverloaded()))
+    {
+        std::this_thread::sleep_for(backOff_);
     }
 
-    return true;
+    return !abort;
+}
+
+bool
+SHAMapStoreImp::copyState(
+    SHAMap const& map,
+    LedgerIndex seq,
+    std::uint64_t& nodeCount)
+{
+    // Copy a single record from node to dbRotating_. Nodes that recent
+    // ledgers already wrote to the writable backend are found there first
+    // and are not copied again.
+    auto copyNode = [this](SHAMapAbstractNode const& node) {
+        dbRotating_->fetch(node.getNodeHash().as_uint256(), node.getSeq());
+    };
+
+    dbRotating_->fetch(map.getHash().as_uint256(), seq);
+    ++nodeCount;
+
+    std::atomic<int> next{0};
+
+    return parallelCopy(nodeCount, [&](std::atomic<bool> const& abort) {
+        std::uint64_t count = 0;
+
+        for (int branch = next++; branch < 16 && !abort; branch = next++)
+        {
+            map.visitBranch(branch, [&](SHAMapAbstractNode& node) {
+                copyNode(node);
+                return copyBackOff(++count, abort);
+            });
+        }
+
+        return count;
+    });
 }
 
 void
@@ -382,11 +481,10 @@ SHAMapStoreImp::run()
 
             JLOG(journal_.debug()) << "copying ledger " << validatedSeq;
             std::uint64_t nodeCount = 0;
-            validatedLedger->stateMap().snapShot(false)->visitNodes(std::bind(
-                &SHAMapStoreImp::copyNode,
-                this,
-                std::ref(nodeCount),
-                std::placeholders::_1));
+            copyState(
+                *validatedLedger->stateMap().snapShot(false),
+                validatedSeq,
+                nodeCount);
             switch (health())
             {
                 case Health::stopping:
@@ -599,23 +697,36 @@ SHAMapStoreImp::clearSql(
         return;
     }
 
-    boost::format formattedDeleteQuery(deleteQuery);
+    // Each batch holds the database's write lock, which blocks readers such
+    // as account_tx. Busy ledgers have many more rows per ledger than quiet
+    // ones, so size the batches by how long they take rather than by a
+    // fixed number of ledgers: shrink a batch that held the lock for too
+    // long, and grow it back toward deleteBatch_ while batches are quick.
+    std::uint32_t batch = deleteBatch_;
 
     JLOG(journal_.debug()) << "start: " << deleteQuery << " from " << min
                            << " to " << lastRotated;
     while (min < lastRotated)
     {
-        min = std::min(lastRotated, min + deleteBatch_);
-        JLOG(journal_.trace()) << "Begin: Delete up to " << deleteBatch_
-                               << " rows with LedgerSeq < " << min
+        min = std::min(lastRotated, min + batch);
+        JLOG(journal_.trace()) << "Begin: Delete up to " << batch
+                               << " ledgers with LedgerSeq < " << min
                                << " using query: " << deleteQuery;
+        auto const start = std::chrono::steady_clock::now();
         {
             auto db = database.checkoutDb();
-            *db << boost::str(formattedDeleteQuery % min);
+            *db << deleteQuery, soci::use(min);
         }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
         JLOG(journal_.trace())
-            << "End: Delete up to " << deleteBatch_ << " rows with LedgerSeq < "
+            << "End: Delete up to " << batch << " ledgers with LedgerSeq < "
             << min << " using query: " << deleteQuery;
+
+        if (elapsed > maxDeleteTime_)
+            batch = std::max(batch / 2, 1u);
+        else if (elapsed < maxDeleteTime_ / 4)
+            batch = std::min(batch * 2, deleteBatch_);
+
         if (health())
             return;
         if (min < lastRotated)
@@ -662,7 +773,7 @@ SHAMapStoreImp::clearPrior(LedgerIndex lastRotated)
         *ledgerDb_,
         lastRotated,
         "SELECT MIN(LedgerSeq) FROM Ledgers;",
-        "DELETE FROM Ledgers WHERE LedgerSeq < %u;");
+        "DELETE FROM Ledgers WHERE LedgerSeq < :seq;");
     if (health())
         return;
 
@@ -670,7 +781,7 @@ SHAMapStoreImp::clearPrior(LedgerIndex lastRotated)
         *transactionDb_,
         lastRotated,
         "SELECT MIN(LedgerSeq) FROM Transactions;",
-        "DELETE FROM Transactions WHERE LedgerSeq < %u;");
+        "DELETE FROM Transactions WHERE LedgerSeq < :seq;");
     if (health())
         return;
 
@@ -678,7 +789,7 @@ SHAMapStoreImp::clearPrior(LedgerIndex lastRotated)
         *transactionDb_,
         lastRotated,
         "SELECT MIN(LedgerSeq) FROM AccountTransactions;",
-        "DELETE FROM AccountTransactions WHERE LedgerSeq < %u;");
+        "DELETE FROM AccountTransactions WHERE LedgerSeq < :seq;");
     if (health())
         return;
 }
@@ -27,6 +27,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <thread>
 
 namespace ripple {
@@ -107,6 +108,10 @@ private:
     std::uint32_t deleteInterval_ = 0;
     bool advisoryDelete_ = false;
     std::uint32_t deleteBatch_ = 100;
+    // longest a single delete batch should hold a database's write lock
+    std::chrono::milliseconds const maxDeleteTime_{100};
+    // number of threads copying nodes into the new writable backend
+    std::uint32_t copyThreads_ = 4;
     std::chrono::milliseconds backOff_{100};
     std::chrono::seconds ageThreshold_{60};
     /// If set, and the node is out of sync during an
@@ -192,9 +197,26 @@ public:
     minimumOnline() const override;
 
 private:
-    // callback for visitNodes
+    /** Run a copy task on copyThreads_ threads
+
+        Each thread calls task with a flag that is set if the copy has to be
+        abandoned, and the task returns how many nodes it copied. health()
+        may sleep, so the calling thread checks it on behalf of the workers.
+
+        @return true if the copy was abandoned.
+    */
+    bool
+    parallelCopy(
+        std::uint64_t& nodeCount,
+        std::function<std::uint64_t(std::atomic<bool> const&)> const& task);
+
+    // Pause a copy thread while the server is under load
+    bool
+    copyBackOff(std::uint64_t nodeCount, std::atomic<bool> const& abort);
+
+    // Copy every node of a state map, split by the branches of its root
     bool
-    copyNode(std::uint64_t& nodeCount, SHAMapAbstractNode const& node);
+    copyState(SHAMap const& map, LedgerIndex seq, std::uint64_t& nodeCount);
     void
     run();
     void
@@ -207,16 +229,22 @@ private:
     bool
     freshenCache(CacheInstance& cache)
     {
-        std::uint64_t check = 0;
-
-        for (auto const& key : cache.getKeys())
-        {
-            dbRotating_->fetch(key, 0);
-            if (!(++check % checkHealthInterval_) && health())
-                return true;
-        }
-
-        return false;
+        auto const keys = cache.getKeys();
+        std::atomic<std::size_t> next{0};
+        std::uint64_t nodeCount = 0;
+
+        return parallelCopy(nodeCount, [&](std::atomic<bool> const& abort) {
+            std::uint64_t check = 0;
+
+            for (auto i = next++; i < keys.size(); i = next++)
+            {
+                dbRotating_->fetch(keys[i], 0);
+                if (!copyBackOff(++check, abort))
+                    break;
+            }
+
+            return check;
+        });
     }
 
     /** delete from sqlite table in batches to not lock the db excessively.
@@ -288,6 +288,25 @@ public:
         ApplyFlags flags,
         beast::Journal j);
 
+    /**
+        Add a new transaction to the open ledger, hold it in the queue,
+        or reject it, reusing the result of an earlier `preflight`.
+
+        This lets the caller do the stateless checks before taking the
+        locks that protect the open ledger. If the rules of the `view`
+        differ from the ones `preflight` ran with, it is run again.
+
+        @param pfresult The result of `preflight` for `tx`. The flags
+                        it was run with are the ones used to apply.
+    */
+    std::pair<TER, bool>
+    apply(
+        Application& app,
+        OpenView& view,
+        std::shared_ptr<STTx const> const& tx,
+        PreflightResult const& pfresult,
+        beast::Journal j);
+
     /**
         Fill the new open ledger with transactions from the queue.
 
@@ -24,7 +24,7 @@
 #include <ripple/app/misc/impl/AccountTxPaging.h>
 #include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/UintTypes.h>
-#include <boost/format.hpp>
+#include <limits>
 #include <memory>
 
 namespace ripple {
@@ -77,8 +77,6 @@ accountTxPage(
     bool bAdmin,
     std::uint32_t page_length)
 {
-    bool lookingForMarker = marker.has_value();
-
     std::uint32_t numberOfResults;
 
     if (limit <= 0 || (limit > page_length && !bAdmin))
@@ -92,101 +90,60 @@ accountTxPage(
     // than the limit), then we return an opaque marker that can be supplied in
     // a subsequent query.
     std::uint32_t queryLimit = numberOfResults + 1;
-    std::uint32_t findLedger = 0, findSeq = 0;
 
-    if (lookingForMarker)
+    // Each page is a single range scan of AcctTxIndex, which covers
+    // (Account, LedgerSeq, TxnSeq). The scan starts at the marker, which is
+    // the first entry not returned by the previous page, or at the end of the
+    // requested ledger range if there is no marker.
+    std::uint32_t findLedger, findSeq;
+
+    if (marker)
     {
         findLedger = marker->ledgerSeq;
         findSeq = marker->txnSeq;
     }
+    else if (forward)
+    {
+        findLedger = minLedger;
+        findSeq = 0;
+    }
+    else
+    {
+        findLedger = maxLedger;
+        findSeq = std::numeric_limits<std::uint32_t>::max();
+    }
 
     // marker is also an output parameter, so need to reset
     marker.reset();
 
-    static std::string const prefix(
+    static std::string const forwardSql(
         R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
           Status,RawTxn,TxnMeta
           FROM AccountTransactions INNER JOIN Transactions
           ON Transactions.TransID = AccountTransactions.TransID
-          AND AccountTransactions.Account = '%s' WHERE
-          )");
-
-    std::string sql;
+          WHERE AccountTransactions.Account = :account AND
+          (AccountTransactions.LedgerSeq, AccountTransactions.TxnSeq) >=
+          (:findLedger, :findSeq) AND
+          AccountTransactions.LedgerSeq <= :maxLedger
+          ORDER BY AccountTransactions.LedgerSeq ASC,
+          AccountTransactions.TxnSeq ASC
+          LIMIT :limit;)");
+
+    static std::string const backwardSql(
+        R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
+          Status,RawTxn,TxnMeta
+          FROM AccountTransactions INNER JOIN Transactions
+          ON Transactions.TransID = AccountTransactions.TransID
+          WHERE AccountTransactions.Account = :account AND
+          (AccountTransactions.LedgerSeq, AccountTransactions.TxnSeq) <=
+          (:findLedger, :findSeq) AND
+          AccountTransactions.LedgerSeq >= :minLedger
+          ORDER BY AccountTransactions.LedgerSeq DESC,
+          AccountTransactions.TxnSeq DESC
+          LIMIT :limit;)");
 
-    // SQL's BETWEEN uses a closed interval ([a,b])
-
-    if (forward && (findLedger == 0))
-    {
-        sql = boost::str(
-            boost::format(
-                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u'
-             ORDER BY AccountTransactions.LedgerSeq ASC,
-             AccountTransactions.TxnSeq ASC
-             LIMIT %u;)")) %
-            idCache.toBase58(account) % minLedger % maxLedger % queryLimit);
-    }
-    else if (forward && (findLedger != 0))
-    {
-        auto b58acct = idCache.toBase58(account);
-        sql = boost::str(
-            boost::format((
-                R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-            Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u')
-            OR
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = '%u' AND
-            AccountTransactions.TxnSeq >= '%u')
-            ORDER BY AccountTransactions.LedgerSeq ASC,
-            AccountTransactions.TxnSeq ASC
-            LIMIT %u;
-            )")) %
-            b58acct % (findLedger + 1) % maxLedger % b58acct % findLedger %
-            findSeq % queryLimit);
-    }
-    else if (!forward && (findLedger == 0))
-    {
-        sql = boost::str(
-            boost::format(
-                prefix + (R"(AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u'
-             ORDER BY AccountTransactions.LedgerSeq DESC,
-             AccountTransactions.TxnSeq DESC
-             LIMIT %u;)")) %
-            idCache.toBase58(account) % minLedger % maxLedger % queryLimit);
-    }
-    else if (!forward && (findLedger != 0))
-    {
-        auto b58acct = idCache.toBase58(account);
-        sql = boost::str(
-            boost::format((
-                R"(SELECT AccountTransactions.LedgerSeq,AccountTransactions.TxnSeq,
-            Status,RawTxn,TxnMeta
-            FROM AccountTransactions, Transactions WHERE
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq BETWEEN '%u' AND '%u')
-            OR
-            (AccountTransactions.TransID = Transactions.TransID AND
-            AccountTransactions.Account = '%s' AND
-            AccountTransactions.LedgerSeq = '%u' AND
-            AccountTransactions.TxnSeq <= '%u')
-            ORDER BY AccountTransactions.LedgerSeq DESC,
-            AccountTransactions.TxnSeq DESC
-            LIMIT %u;
-            )")) %
-            b58acct % minLedger % (findLedger - 1) % b58acct % findLedger %
-            findSeq % queryLimit);
-    }
-    else
-    {
-        assert(false);
-        // sql is empty
-        return;
-    }
+    auto const b58acct = idCache.toBase58(account);
+    std::uint32_t const lastLedger = forward ? maxLedger : minLedger;
 
     {
         auto db(connection.checkoutDb());
@@ -202,7 +159,12 @@ accountTxPage(
         soci::indicator dataPresent, metaPresent;
 
         soci::statement st =
-            (db->prepare << sql,
+            (db->prepare << (forward ? forwardSql : backwardSql),
+             soci::use(b58acct),
+             soci::use(findLedger),
+             soci::use(findSeq),
+             soci::use(lastLedger),
+             soci::use(queryLimit),
              soci::into(ledgerSeq),
              soci::into(txnSeq),
              soci::into(status),
@@ -213,15 +175,7 @@ accountTxPage(
 
         while (st.fetch())
         {
-            if (lookingForMarker)
-            {
-                if (findLedger == ledgerSeq.value_or(0) &&
-                    findSeq == txnSeq.value_or(0))
-                {
-                    lookingForMarker = false;
-                }
-            }
-            else if (numberOfResults == 0)
+            if (numberOfResults == 0)
             {
                 marker = {
                     rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
@@ -229,39 +183,36 @@ accountTxPage(
                 break;
             }
 
-            if (!lookingForMarker)
-            {
-                if (dataPresent == soci::i_ok)
-                    convert(txnData, rawData);
-                else
-                    rawData.clear();
-
-                if (metaPresent == soci::i_ok)
-                    convert(txnMeta, rawMeta);
-                else
-                    rawMeta.clear();
-
-                // Work around a bug that could leave the metadata missing
-                if (rawMeta.size() == 0)
-                    onUnsavedLedger(ledgerSeq.value_or(0));
-
-                // `rawData` and `rawMeta` will be used after they are moved.
-                // That's OK.
-                onTransaction(
-                    rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
-                    *status,
-                    std::move(rawData),
-                    std::move(rawMeta));
-                // Note some callbacks will move the data, some will not. Clear
-                // them so code doesn't depend on if the data was actually moved
-                // or not. The code will be more efficient if `rawData` and
-                // `rawMeta` don't have to allocate in `convert`, so don't
-                // refactor my moving these variables into loop scope.
+            if (dataPresent == soci::i_ok)
+                convert(txnData, rawData);
+            else
                 rawData.clear();
+
+            if (metaPresent == soci::i_ok)
+                convert(txnMeta, rawMeta);
+            else
                 rawMeta.clear();
 
-                --numberOfResults;
-            }
+            // Work around a bug that could leave the metadata missing
+            if (rawMeta.size() == 0)
+                onUnsavedLedger(ledgerSeq.value_or(0));
+
+            // `rawData` and `rawMeta` will be used after they are moved.
+            // That's OK.
+            onTransaction(
+                rangeCheckedCast<std::uint32_t>(ledgerSeq.value_or(0)),
+                *status,
+                std::move(rawData),
+                std::move(rawMeta));
+            // Note some callbacks will move the data, some will not. Clear
+            // them so code doesn't depend on if the data was actually moved
+            // or not. The code will be more efficient if `rawData` and
+            // `rawMeta` don't have to allocate in `convert`, so don't
+            // refactor my moving these variables into loop scope.
+            rawData.clear();
+            rawMeta.clear();
+
+            --numberOfResults;
         }
     }
 
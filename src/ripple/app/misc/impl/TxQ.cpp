@@ -611,13 +611,35 @@ TxQ::apply(
     ApplyFlags flags,
     beast::Journal j)
 {
-    auto const account = (*tx)[sfAccount];
-    auto const transactionID = tx->getTransactionID();
-    auto const tSeq = tx->getSequence();
     // See if the transaction is valid, properly formed,
     // etc. before doing potentially expensive queue
     // replace and multi-transaction operations.
-    auto const pfresult = preflight(app, view.rules(), *tx, flags, j);
+    return apply(app, view, tx, preflight(app, view.rules(), *tx, flags, j), j);
+}
+
+std::pair<TER, bool>
+TxQ::apply(
+    Application& app,
+    OpenView& view,
+    std::shared_ptr<STTx const> const& tx,
+    PreflightResult const& pfresult,
+    beast::Journal j)
+{
+    assert(&pfresult.tx == tx.get());
+
+    // If the rules changed since the transaction was checked,
+    // preflight again
+    if (pfresult.rules != view.rules())
+    {
+        JLOG(j.debug()) << "Transaction " << tx->getTransactionID()
+                        << " rules have changed since preflight";
+        return apply(app, view, tx, pfresult.flags, j);
+    }
+
+    auto flags = pfresult.flags;
+    auto const account = (*tx)[sfAccount];
+    auto const transactionID = tx->getTransactionID();
+    auto const tSeq = tx->getSequence();
     if (pfresult.ter != tesSUCCESS)
         return {pfresult.ter, false};
 
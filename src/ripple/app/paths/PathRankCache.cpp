@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2020 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <ripple/app/paths/PathRankCache.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/Serializer.h>
+#include <algorithm>
+
+namespace ripple {
+
+uint256
+PathRankCache::makeKey(
+    STPath const& path,
+    AccountID const& srcAccount,
+    AccountID const& dstAccount,
+    STAmount const& srcAmount,
+    STAmount const& dstAmount,
+    STAmount const& minDstAmount,
+    bool convertAll)
+{
+    Serializer s;
+    STPathSet paths;
+    paths.push_back(path);
+    paths.add(s);
+    s.addBitString(srcAccount);
+    s.addBitString(dstAccount);
+    srcAmount.add(s);
+    dstAmount.add(s);
+    minDstAmount.add(s);
+    s.add8(convertAll ? 1 : 0);
+    return s.getSHA512Half();
+}
+
+// Whether the result may differ given the entries that changed
+static bool
+isAffected(
+    PathRankCache::Dependencies const& deps,
+    std::vector<uint256> const& changed)
+{
+    for (auto const& key : deps.keys)
+    {
+        if (std::binary_search(changed.begin(), changed.end(), key))
+            return true;
+    }
+
+    for (auto const& [first, last] : deps.ranges)
+    {
+        auto const it = std::upper_bound(changed.begin(), changed.end(), first);
+        if (it != changed.end() && (!last || *it < *last))
+            return true;
+    }
+
+    return false;
+}
+
+void
+PathRankCache::update(RippleLineCache const& cache)
+{
+    auto const& ledger = *cache.getLedger();
+    auto const& changed = cache.getChangedKeys();
+
+    std::lock_guard sl(mutex_);
+
+    if (ledgerHash_ && *ledgerHash_ == ledger.info().hash && !ledger.open())
+        return;
+
+    // Fees and amendments apply to every path
+    auto const global = [&changed] {
+        for (auto const& key : {keylet::fees().key, keylet::amendments().key})
+        {
+            if (std::binary_search(changed->begin(), changed->end(), key))
+                return true;
+        }
+        return false;
+    };
+
+    if (ledger.open() || !ledgerHash_ || !changed ||
+        ledger.info().parentHash != *ledgerHash_ || global())
+    {
+        entries_.clear();
+        ledgerHash_ = ledger.open() ? boost::none
+                                    : boost::make_optional(ledger.info().hash);
+        return;
+    }
+
+    auto const closeTime = ledger.parentCloseTime();
+    for (auto it = entries_.begin(); it != entries_.end();)
+    {
+        auto& entry = it->second;
+        if (!entry.used || isAffected(entry.deps, *changed) ||
+            (entry.deps.expiration && *entry.deps.expiration <= closeTime))
+        {
+            it = entries_.erase(it);
+        }
+        else
+        {
+            entry.used = false;
+            ++it;
+        }
+    }
+
+    ledgerHash_ = ledger.info().hash;
+}
+
+bool
+PathRankCache::isCurrent(ReadView const& ledger) const
+{
+    return !ledger.open() && ledgerHash_ && *ledgerHash_ == ledger.info().hash;
+}
+
+boost::optional<PathRankCache::Result>
+PathRankCache::find(uint256 const& key, ReadView const& ledger)
+{
+    std::lock_guard sl(mutex_);
+
+    if (!isCurrent(ledger))
+        return boost::none;
+
+    auto const it = entries_.find(key);
+    if (it == entries_.end())
+        return boost::none;
+
+    it->second.used = true;
+    return it->second.result;
+}
+
+void
+PathRankCache::insert(
+    uint256 const& key,
+    ReadView const& ledger,
+    Result const& result,
+    Dependencies&& deps)
+{
+    std::sort(deps.keys.begin(), deps.keys.end());
+    deps.keys.erase(
+        std::unique(deps.keys.begin(), deps.keys.end()), deps.keys.end());
+
+    std::lock_guard sl(mutex_);
+
+    if (isCurrent(ledger))
+        entries_[key] = {result, std::move(deps), true};
+}
+
+//------------------------------------------------------------------------------
+
+bool
+DependencyRecorder::exists(Keylet const& k) const
+{
+    deps_.keys.push_back(k.key);
+    return base_.exists(k);
+}
+
+auto
+DependencyRecorder::succ(
+    key_type const& key,
+    boost::optional<key_type> const& last) const -> boost::optional<key_type>
+{
+    deps_.ranges.emplace_back(key, last);
+    return base_.succ(key, last);
+}
+
+std::shared_ptr<SLE const>
+DependencyRecorder::read(Keylet const& k) const
+{
+    deps_.keys.push_back(k.key);
+    auto sle = base_.read(k);
+
+    // An offer stops being usable once it expires, even if nothing changes it
+    if (sle && sle->getType() == ltOFFER && sle->isFieldPresent(sfExpiration))
+    {
+        NetClock::time_point const expiration{
+            NetClock::duration{sle->getFieldU32(sfExpiration)}};
+        if (!deps_.expiration || expiration < *deps_.expiration)
+            deps_.expiration = expiration;
+    }
+
+    return sle;
+}
+
+}  // namespace ripple
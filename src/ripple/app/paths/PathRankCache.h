@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2020 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_APP_PATHS_PATHRANKCACHE_H_INCLUDED
+#define RIPPLE_APP_PATHS_PATHRANKCACHE_H_INCLUDED
+
+#include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/STPathSet.h>
+#include <ripple/protocol/TER.h>
+#include <boost/optional.hpp>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** Remembers the liquidity and quality found for the paths of a request.
+
+    Each result records the ledger entries that computing it read. When
+    the request is updated for the next ledger, only the results that
+    read an entry changed by that ledger's transactions are forgotten.
+    The others are reused instead of running the payment engine again.
+*/
+class PathRankCache
+{
+public:
+    /** The ledger entries a result depends on. */
+    struct Dependencies
+    {
+        // Entries that were read, or checked for existence
+        std::vector<uint256> keys;
+
+        // Ranges that were searched for the next entry. The end of
+        // the range is unbounded if not set.
+        std::vector<std::pair<uint256, boost::optional<uint256>>> ranges;
+
+        // The earliest expiration of any offer that was read
+        boost::optional<NetClock::time_point> expiration;
+    };
+
+    struct Result
+    {
+        TER ter;
+        STAmount liquidity;
+        std::uint64_t quality;
+    };
+
+    PathRankCache() = default;
+    PathRankCache(PathRankCache const&) = delete;
+    PathRankCache&
+    operator=(PathRankCache const&) = delete;
+
+    /** Identifies the result of ranking a path with given amounts. */
+    static uint256
+    makeKey(
+        STPath const& path,
+        AccountID const& srcAccount,
+        AccountID const& dstAccount,
+        STAmount const& srcAmount,
+        STAmount const& dstAmount,
+        STAmount const& minDstAmount,
+        bool convertAll);
+
+    /** Move on to the ledger of `cache`.
+
+        Results that may differ in the new ledger are forgotten, as are
+        results that were not used in the previous ledger. Everything is
+        forgotten unless `cache` was created from the cache of the ledger
+        the results were computed in.
+    */
+    void
+    update(RippleLineCache const& cache);
+
+    /** Returns the result for `key` in `ledger`, if known. */
+    boost::optional<Result>
+    find(uint256 const& key, ReadView const& ledger);
+
+    /** Remember a result computed in `ledger`. */
+    void
+    insert(
+        uint256 const& key,
+        ReadView const& ledger,
+        Result const& result,
+        Dependencies&& deps);
+
+private:
+    struct Entry
+    {
+        Result result;
+        Dependencies deps;
+        bool used;
+    };
+
+    bool
+    isCurrent(ReadView const& ledger) const;
+
+    std::mutex mutex_;
+    boost::optional<uint256> ledgerHash_;
+    hash_map<uint256, Entry> entries_;
+};
+
+/** A view that records the entries read through it.
+
+    Used while computing a result for the PathRankCache.
+*/
+class DependencyRecorder final : public ReadView
+{
+    ReadView const& base_;
+    PathRankCache::Dependencies& deps_;
+
+public:
+    DependencyRecorder(
+        ReadView const& base,
+        PathRankCache::Dependencies& deps)
+        : base_(base), deps_(deps)
+    {
+    }
+
+    DependencyRecorder(DependencyRecorder const&) = delete;
+    DependencyRecorder&
+    operator=(DependencyRecorder const&) = delete;
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists(Keylet const& k) const override;
+
+    boost::optional<key_type>
+    succ(
+        key_type const& key,
+        boost::optional<key_type> const& last = boost::none) const override;
+
+    std::shared_ptr<SLE const>
+    read(Keylet const& k) const override;
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound(key_type const& key) const override
+    {
+        return base_.slesUpperBound(key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists(key_type const& key) const override
+    {
+        return base_.txExists(key);
+    }
+
+    tx_type
+    txRead(key_type const& key) const override
+    {
+        return base_.txRead(key);
+    }
+};
+
+}  // namespace ripple
+
+#endif
@@ -151,6 +151,13 @@ PathRequest::hasCompletion()
     return bool(fCompletion);
 }
 
+std::pair<AccountID, Currency>
+PathRequest::getLineGroup()
+{
+    std::lock_guard sl(mLock);
+    return {raSrcAccount.value_or(AccountID{}), saDstAmount.getCurrency()};
+}
+
 void
 PathRequest::updateComplete()
 {
@@ -476,7 +483,7 @@ PathRequest::getPathFinder(
         saSendMax,
         app_);
     if (pathfinder->findPaths(level))
-        pathfinder->computePathRanks(max_paths_);
+        pathfinder->computePathRanks(max_paths_, &mRankCache);
     else
         pathfinder.reset();  // It's a bad request - clear it.
     return currency_map[currency] = std::move(pathfinder);
@@ -509,6 +516,7 @@ PathRequest::findPaths(
         ? STAmount(
               saDstAmount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset)
         : saDstAmount;
+    mRankCache.update(*cache);
     hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
     for (auto const& issue : sourceCurrencies)
     {
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_PATHREQUEST_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathRankCache.h>
 #include <ripple/app/paths/Pathfinder.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/json/json_value.h>
@@ -109,6 +110,11 @@ public:
     bool
     hasCompletion();
 
+    // Requests with the same source account and destination currency
+    // mostly look at the same trust lines.
+    std::pair<AccountID, Currency>
+    getLineGroup();
+
 private:
     bool
     isValid(std::shared_ptr<RippleLineCache> const& crCache);
@@ -155,6 +161,9 @@ private:
     std::set<Issue> sciSourceCurrencies;
     std::map<Issue, STPathSet> mContext;
 
+    // Liquidity of the paths found in earlier ledgers
+    PathRankCache mRankCache;
+
     bool convert_all_;
 
     std::recursive_mutex mIndexLock;
@@ -20,6 +20,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/paths/PathRequests.h>
+#include <ripple/app/paths/Tuning.h>
 #include <ripple/basics/Log.h>
 #include <ripple/core/JobQueue.h>
 #include <ripple/net/RPCErr.h>
@@ -27,6 +28,7 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/resource/Fees.h>
 #include <algorithm>
+#include <condition_variable>
 
 namespace ripple {
 
@@ -49,11 +51,67 @@ PathRequests::getLineCache(
          ((lgrSeq + 8) < lineSeq)) ||  // we jumped way back for some reason
         (lgrSeq > (lineSeq + 8)))      // we jumped way forward for some reason
     {
-        mLineCache = std::make_shared<RippleLineCache>(ledger);
+        // Keep what pathfinding learned about the previous ledger's lines
+        if (mLineCache && lgrSeq > lineSeq)
+            mLineCache = std::make_shared<RippleLineCache>(ledger, *mLineCache);
+        else
+            mLineCache = std::make_shared<RippleLineCache>(ledger);
     }
     return mLineCache;
 }
 
+namespace {
+
+// Path requests split into groups that are updated in parallel. Each
+// group is updated by one thread, in order.
+struct UpdateGroups
+{
+    using Update = std::function<bool(PathRequest::wptr const&)>;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::vector<PathRequest::wptr>> groups;
+    // Only called while a group is being updated, since it refers to
+    // the state of the updateAll call that created it.
+    Update update;
+    std::size_t next = 0;
+    int active = 0;
+    bool stop = false;
+
+    // Update groups until there are none left or an update returns false.
+    // Called by the thread running updateAll and by helper jobs, which
+    // may start after updateAll has moved on and then find nothing to do.
+    void
+    run()
+    {
+        std::unique_lock lock(mutex);
+        while (!stop && next < groups.size())
+        {
+            auto const& group = groups[next++];
+            ++active;
+            lock.unlock();
+
+            bool keepGoing = true;
+            for (auto const& wr : group)
+            {
+                if (!update(wr))
+                {
+                    keepGoing = false;
+                    break;
+                }
+            }
+
+            lock.lock();
+            --active;
+            if (!keepGoing)
+                stop = true;
+        }
+        cv.notify_all();
+    }
+};
+
+}  // namespace
+
 void
 PathRequests::updateAll(
     std::shared_ptr<ReadView const> const& inLedger,
@@ -73,86 +131,126 @@ PathRequests::updateAll(
     }
 
     bool newRequests = app_.getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    std::atomic<bool> mustBreak{false};
 
     JLOG(mJournal.trace()) << "updateAll seq=" << cache->getLedger()->seq()
                            << ", " << requests.size() << " requests";
 
-    int processed = 0, removed = 0;
+    std::atomic<int> processed{0}, removed{0};
 
-    do
-    {
-        for (auto const& wr : requests)
-        {
-            if (shouldCancel())
-                break;
+    // Returns false once the remaining requests should wait for another
+    // pass. May be called from several threads at once.
+    auto const updateRequest = [&](PathRequest::wptr const& wr) {
+        if (shouldCancel())
+            return false;
 
-            auto request = wr.lock();
-            bool remove = true;
+        auto request = wr.lock();
+        bool remove = true;
 
-            if (request)
+        if (request)
+        {
+            if (!request->needsUpdate(newRequests, cache->getLedger()->seq()))
+                remove = false;
+            else
             {
-                if (!request->needsUpdate(
-                        newRequests, cache->getLedger()->seq()))
-                    remove = false;
-                else
+                if (auto ipSub = request->getSubscriber())
                 {
-                    if (auto ipSub = request->getSubscriber())
+                    if (!ipSub->getConsumer().warn())
                     {
-                        if (!ipSub->getConsumer().warn())
-                        {
-                            Json::Value update =
-                                request->doUpdate(cache, false);
-                            request->updateComplete();
-                            update[jss::type] = "path_find";
-                            ipSub->send(update, false);
-                            remove = false;
-                            ++processed;
-                        }
-                    }
-                    else if (request->hasCompletion())
-                    {
-                        // One-shot request with completion function
-                        request->doUpdate(cache, false);
+                        Json::Value update = request->doUpdate(cache, false);
                         request->updateComplete();
+                        update[jss::type] = "path_find";
+                        ipSub->send(update, false);
+                        remove = false;
                         ++processed;
                     }
                 }
+                else if (request->hasCompletion())
+                {
+                    // One-shot request with completion function
+                    request->doUpdate(cache, false);
+                    request->updateComplete();
+                    ++processed;
+                }
             }
+        }
+
+        if (remove)
+        {
+            std::lock_guard sl(mLock);
+
+            // Remove any dangling weak pointers or weak
+            // pointers that refer to this path request.
+            auto ret = std::remove_if(
+                requests_.begin(),
+                requests_.end(),
+                [&removed, &request](auto const& wl) {
+                    auto r = wl.lock();
+
+                    if (r && r != request)
+                        return false;
+                    ++removed;
+                    return true;
+                });
+
+            requests_.erase(ret, requests_.end());
+        }
+
+        // We weren't handling new requests and then
+        // there was a new request
+        if (!newRequests && app_.getLedgerMaster().isNewPathRequest())
+            mustBreak = true;
 
-            if (remove)
+        return !mustBreak;
+    };
+
+    do
+    {
+        // Requests that look at the same trust lines go in the same group,
+        // so the lines one loads are usually in the cache for the next.
+        auto work = std::make_shared<UpdateGroups>();
+        {
+            hash_map<std::pair<AccountID, Currency>, std::size_t> index;
+            for (auto const& wr : requests)
             {
-                std::lock_guard sl(mLock);
-
-                // Remove any dangling weak pointers or weak
-                // pointers that refer to this path request.
-                auto ret = std::remove_if(
-                    requests_.begin(),
-                    requests_.end(),
-                    [&removed, &request](auto const& wl) {
-                        auto r = wl.lock();
-
-                        if (r && r != request)
-                            return false;
-                        ++removed;
-                        return true;
-                    });
-
-                requests_.erase(ret, requests_.end());
+                auto const request = wr.lock();
+                auto const key = request ? request->getLineGroup()
+                                         : std::pair<AccountID, Currency>{};
+                auto const [it, inserted] =
+                    index.emplace(key, work->groups.size());
+                if (inserted)
+                    work->groups.emplace_back();
+                work->groups[it->second].push_back(wr);
             }
+        }
+        work->update = updateRequest;
+
+        // This thread updates groups too, so one fewer helper is needed
+        auto const helpers = work->groups.empty()
+            ? 0
+            : std::min<std::size_t>(
+                  work->groups.size() - 1, PATHFINDER_MAX_HELPER_JOBS);
+        for (std::size_t i = 0; i < helpers; ++i)
+        {
+            app_.getJobQueue().addJob(
+                jtUPDATE_PF, "PathRequest::updateAll", [work](Job&) {
+                    work->run();
+                });
+        }
 
-            mustBreak =
-                !newRequests && app_.getLedgerMaster().isNewPathRequest();
-
-            // We weren't handling new requests and then
-            // there was a new request
-            if (mustBreak)
-                break;
+        work->run();
+        {
+            // Wait for the helpers still updating a group. Any that start
+            // later will find that there is no work left.
+            std::unique_lock lock(work->mutex);
+            work->cv.wait(lock, [&work] { return work->active == 0; });
+            work->stop = true;
         }
 
         if (mustBreak)
         {  // a new request came in while we were working
             newRequests = true;
+            mustBreak = false;
         }
         else if (newRequests)
         {  // we only did new requests, so we always need a last pass
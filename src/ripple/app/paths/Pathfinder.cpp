@@ -336,13 +336,55 @@ Pathfinder::getPathLiquidity(
     STAmount& amountOut,           // OUT: The actual liquidity along the path.
     uint64_t& qualityOut) const    // OUT: The returned initial quality
 {
+    boost::optional<uint256> cacheKey;
+    if (mRankCache)
+    {
+        cacheKey = PathRankCache::makeKey(
+            path,
+            mSrcAccount,
+            mDstAccount,
+            mSrcAmount,
+            mDstAmount,
+            minDstAmount,
+            convert_all_);
+
+        if (auto const cached = mRankCache->find(*cacheKey, *mLedger))
+        {
+            amountOut = cached->liquidity;
+            qualityOut = cached->quality;
+            return cached->ter;
+        }
+    }
+
+    // Record what the calculation reads, so its result can be cached
+    PathRankCache::Dependencies deps;
+    boost::optional<DependencyRecorder> recorder;
+    if (cacheKey)
+        recorder.emplace(*mLedger, deps);
+
+    auto const remember = [&](TER ter) {
+        if (cacheKey)
+        {
+            PathRankCache::Result result{ter, STAmount{}, 0};
+            if (ter == tesSUCCESS)
+            {
+                result.liquidity = amountOut;
+                result.quality = qualityOut;
+            }
+            mRankCache->insert(*cacheKey, *mLedger, result, std::move(deps));
+        }
+        return ter;
+    };
+
     STPathSet pathSet;
     pathSet.push_back(path);
 
     path::RippleCalc::Input rcInput;
     rcInput.defaultPathsAllowed = false;
 
-    PaymentSandbox sandbox(&*mLedger, tapNONE);
+    PaymentSandbox sandbox(
+        recorder ? static_cast<ReadView const*>(&*recorder) : &*mLedger,
+        tapNONE);
 
     try
     {
@@ -361,7 +403,7 @@ Pathfinder::getPathLiquidity(
             &rcInput);
         // If we can't get even the minimum liquidity requested, we're done.
         if (rc.result() != tesSUCCESS)
-            return rc.result();
+            return remember(rc.result());
 
         qualityOut = getRate(rc.actualAmountOut, rc.actualAmountIn);
         amountOut = rc.actualAmountOut;
@@ -385,7 +427,7 @@ Pathfinder::getPathLiquidity(
                 amountOut += rc.actualAmountOut;
         }
 
-        return tesSUCCESS;
+        return remember(tesSUCCESS);
     }
     catch (std::exception const& e)
     {
@@ -408,8 +450,10 @@ smallestUsefulAmount(STAmount const& amount, int maxPaths)
 }  // namespace
 
 void
-Pathfinder::computePathRanks(int maxPaths)
+Pathfinder::computePathRanks(int maxPaths, PathRankCache* rankCache)
 {
+    mRankCache = rankCache;
+
     mRemainingAmount = convert_all_
         ? STAmount(
               mDstAmount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset)
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_PATHS_PATHFINDER_H_INCLUDED
 
 #include <ripple/app/ledger/Ledger.h>
+#include <ripple/app/paths/PathRankCache.h>
 #include <ripple/app/paths/RippleLineCache.h>
 #include <ripple/core/LoadEvent.h>
 #include <ripple/protocol/STAmount.h>
@@ -58,9 +59,13 @@ public:
     bool
     findPaths(int searchLevel);
 
-    /** Compute the rankings of the paths. */
+    /** Compute the rankings of the paths.
+
+        @param rankCache If set, the liquidity of paths that did not change
+                         since an earlier ledger is taken from it.
+    */
     void
-    computePathRanks(int maxPaths);
+    computePathRanks(int maxPaths, PathRankCache* rankCache = nullptr);
 
     /* Get the best paths, up to maxPaths in number, from mCompletePaths.
 
@@ -195,6 +200,7 @@ private:
     std::shared_ptr<ReadView const> mLedger;
     std::unique_ptr<LoadEvent> m_loadEvent;
     std::shared_ptr<RippleLineCache> mRLCache;
+    PathRankCache* mRankCache = nullptr;
 
     STPathElement mSource;
     STPathSet mCompletePaths;
@@ -18,7 +18,9 @@
 //==============================================================================
 
 #include <ripple/app/paths/RippleLineCache.h>
+#include <ripple/basics/Log.h>
 #include <ripple/ledger/OpenView.h>
+#include <algorithm>
 
 namespace ripple {
 
@@ -30,20 +32,106 @@ RippleLineCache::RippleLineCache(std::shared_ptr<ReadView const> const& ledger)
     mLedger = std::make_shared<OpenView>(&*ledger, ledger);
 }
 
+// Find the entries that the transactions in a closed ledger created,
+// modified or deleted, and the accounts at either end of the trust lines
+// among them. Returns false if the metadata could not be read.
+static bool
+getLedgerChanges(
+    ReadView const& ledger,
+    std::vector<uint256>& keys,
+    hash_set<AccountID>& accounts)
+{
+    try
+    {
+        for (auto const& item : ledger.txs)
+        {
+            if (!item.second)
+                return false;
+
+            for (auto const& node : item.second->getFieldArray(sfAffectedNodes))
+            {
+                keys.push_back(node.getFieldH256(sfLedgerIndex));
+
+                if (node.getFieldU16(sfLedgerEntryType) != ltRIPPLE_STATE)
+                    continue;
+
+                auto const& fields = node.getFName() == sfCreatedNode
+                    ? sfNewFields
+                    : sfFinalFields;
+                auto const data =
+                    dynamic_cast<STObject const*>(node.peekAtPField(fields));
+
+                if (!data || !data->isFieldPresent(sfLowLimit) ||
+                    !data->isFieldPresent(sfHighLimit))
+                    return false;
+
+                accounts.insert(data->getFieldAmount(sfLowLimit).getIssuer());
+                accounts.insert(data->getFieldAmount(sfHighLimit).getIssuer());
+            }
+        }
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return true;
+}
+
+RippleLineCache::RippleLineCache(
+    std::shared_ptr<ReadView const> const& ledger,
+    RippleLineCache& parent)
+    : RippleLineCache(ledger)
+{
+    auto const& base = *parent.mLedger;
+
+    if (ledger->open() || base.open() ||
+        ledger->info().seq != base.info().seq + 1 ||
+        ledger->info().parentHash != base.info().hash)
+        return;
+
+    std::vector<uint256> keys;
+    hash_set<AccountID> changed;
+    if (!getLedgerChanges(*ledger, keys, changed))
+        return;
+
+    mChangedKeys = std::move(keys);
+
+    std::lock_guard sl(parent.mLock);
+
+    lines_.reserve(parent.lines_.size());
+    for (auto const& [key, lines] : parent.lines_)
+    {
+        // Keys hash differently in each cache
+        if (changed.count(key.account_) == 0)
+            lines_.emplace(
+                AccountKey(key.account_, hasher_(key.account_)), lines);
+    }
+}
+
 std::vector<RippleState::pointer> const&
 RippleLineCache::getRippleLines(AccountID const& accountID)
 {
     AccountKey key(accountID, hasher_(accountID));
 
-    std::lock_guard sl(mLock);
+    {
+        std::lock_guard sl(mLock);
 
-    auto [it, inserted] =
-        lines_.emplace(key, std::vector<RippleState::pointer>());
+        auto const it = lines_.find(key);
+        if (it != lines_.end())
+            return *it->second;
+    }
 
-    if (inserted)
-        it->second = getRippleStateItems(accountID, *mLedger);
+    // Read the lines without holding the lock, so that other threads
+    // looking at other accounts are not held up. If two threads load the
+    // same account at once, the first to finish is kept.
+    auto lines = std::make_shared<std::vector<RippleState::pointer> const>(
+        getRippleStateItems(accountID, *mLedger));
 
-    return it->second;
+    std::lock_guard sl(mLock);
+    return *lines_.emplace(key, std::move(lines)).first->second;
 }
 
 }  // namespace ripple
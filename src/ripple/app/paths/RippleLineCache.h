@@ -23,6 +23,7 @@
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/paths/RippleState.h>
 #include <ripple/basics/hardened_hash.h>
+#include <boost/optional.hpp>
 #include <cstddef>
 #include <memory>
 #include <mutex>
@@ -30,12 +31,24 @@
 
 namespace ripple {
 
-// Used by Pathfinder
+// Used by Pathfinder. Safe to share between threads: the lines of an
+// account, once loaded, are never modified or removed.
 class RippleLineCache
 {
 public:
     explicit RippleLineCache(std::shared_ptr<ReadView const> const& l);
 
+    /** Create a cache for a ledger that follows the one `parent` caches.
+
+        The lines `parent` loaded are kept for every account whose trust
+        lines were not changed by the transactions in `l`, so that they
+        need not be read again. If `l` is not the closed ledger that
+        immediately follows the parent's, the cache starts out empty.
+    */
+    RippleLineCache(
+        std::shared_ptr<ReadView const> const& l,
+        RippleLineCache& parent);
+
     std::shared_ptr<ReadView const> const&
     getLedger() const
     {
@@ -45,11 +58,23 @@ public:
     std::vector<RippleState::pointer> const&
     getRippleLines(AccountID const& accountID);
 
+    /** The sorted keys of the entries changed since the parent's ledger.
+
+        Only set if this cache was created from the cache of the parent
+        ledger, so that users can carry their own state over the same way.
+    */
+    boost::optional<std::vector<uint256>> const&
+    getChangedKeys() const
+    {
+        return mChangedKeys;
+    }
+
 private:
     std::mutex mLock;
 
     ripple::hardened_hash<> hasher_;
     std::shared_ptr<ReadView const> mLedger;
+    boost::optional<std::vector<uint256>> mChangedKeys;
 
     struct AccountKey
     {
@@ -90,8 +115,10 @@ private:
         };
     };
 
-    hash_map<AccountKey, std::vector<RippleState::pointer>, AccountKey::Hash>
-        lines_;
+    // Shared with the caches of later ledgers
+    using Lines = std::shared_ptr<std::vector<RippleState::pointer> const>;
+
+    hash_map<AccountKey, Lines, AccountKey::Hash> lines_;
 };
 
 }  // namespace ripple
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <cstddef>
+#include <cstdint>
 
 namespace ripple {
 
@@ -63,6 +64,96 @@ static_assert(calculatePercent(50'000'000, 100'000'000) == 50);
 static_assert(calculatePercent(50'000'001, 100'000'000) == 51);
 static_assert(calculatePercent(99'999'999, 100'000'000) == 100);
 
+namespace detail {
+
+inline constexpr std::uint64_t powersOfTen[] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull};
+
+}  // namespace detail
+
+/** Returns 10 raised to the power `n`.
+
+    @note `n` must be in the range [0, 19].
+*/
+constexpr std::uint64_t
+powerOfTen(int n)
+{
+    assert(n >= 0 && n < 20);
+    return detail::powersOfTen[n];
+}
+
+/** Returns the number of decimal digits needed to print `v`.
+
+    The digit count is estimated from the position of the highest set
+    bit (log10(2) is about 1233/4096) and corrected with one table
+    lookup, so no loop or division is needed.
+
+    @note `v` must not be zero.
+*/
+constexpr int
+decimalDigits(std::uint64_t v)
+{
+    assert(v != 0);
+#if defined(__GNUC__)
+    int const bits = 64 - __builtin_clzll(v);
+#else
+    int bits = 0;
+    for (auto n = v; n != 0; n >>= 1)
+        ++bits;
+#endif
+    int const guess = (bits * 1233) >> 12;
+    return guess + (v >= detail::powersOfTen[guess] ? 1 : 0);
+}
+
+/** Drops the `n` least significant decimal digits of `v`.
+
+    The result is the same as dividing `v` by 10, `n` times, each
+    time truncating toward zero.
+
+    @note `n` must not be negative.
+*/
+constexpr std::int64_t
+dropDigits(std::int64_t v, int n)
+{
+    assert(n >= 0);
+    // 10^19 exceeds every std::int64_t, so nothing is left
+    if (n > 18)
+        return 0;
+    return v / static_cast<std::int64_t>(detail::powersOfTen[n]);
+}
+
+static_assert(decimalDigits(1) == 1);
+static_assert(decimalDigits(9) == 1);
+static_assert(decimalDigits(10) == 2);
+static_assert(decimalDigits(999'999'999'999'999) == 15);
+static_assert(decimalDigits(1'000'000'000'000'000) == 16);
+static_assert(decimalDigits(9'999'999'999'999'999) == 16);
+static_assert(decimalDigits(10'000'000'000'000'000) == 17);
+static_assert(decimalDigits(18'446'744'073'709'551'615ull) == 20);
+static_assert(dropDigits(123'456, 2) == 1'234);
+static_assert(dropDigits(-123'456, 2) == -1'234);
+static_assert(dropDigits(-123'456, 7) == 0);
+static_assert(dropDigits(9'223'372'036'854'775'807, 19) == 0);
+
 }  // namespace ripple
 
 #endif
@@ -142,6 +142,15 @@ public:
     virtual Json::Value
     currentJson() const = 0;
 
+    /**
+     * Render latency percentiles of RPC calls and of jobs' queued and
+     * running times in Json
+     *
+     * @return Latency percentiles by RPC command and job type
+     */
+    virtual Json::Value
+    latencyJson() const = 0;
+
     /**
      * Ensure enough room to store each currently executing job
      *
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/IOUAmount.h>
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/contract.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <algorithm>
@@ -48,19 +49,21 @@ IOUAmount::normalize()
     if (negative)
         mantissa_ = -mantissa_;
 
-    while ((mantissa_ < minMantissa) && (exponent_ > minExponent))
+    if ((mantissa_ < minMantissa) && (exponent_ > minExponent))
     {
-        mantissa_ *= 10;
-        --exponent_;
+        auto const scale =
+            std::min(16 - decimalDigits(mantissa_), exponent_ - minExponent);
+        mantissa_ *= static_cast<std::int64_t>(powerOfTen(scale));
+        exponent_ -= scale;
     }
-
-    while (mantissa_ > maxMantissa)
+    else if (mantissa_ > maxMantissa)
     {
-        if (exponent_ >= maxExponent)
+        auto const scale = decimalDigits(mantissa_) - 16;
+        if (exponent_ + scale > maxExponent)
             Throw<std::overflow_error>("IOUAmount::normalize");
 
-        mantissa_ /= 10;
-        ++exponent_;
+        mantissa_ /= static_cast<std::int64_t>(powerOfTen(scale));
+        exponent_ += scale;
     }
 
     if ((exponent_ < minExponent) || (mantissa_ < minMantissa))
@@ -91,16 +94,15 @@ IOUAmount::operator+=(IOUAmount const& other)
     auto m = other.mantissa_;
     auto e = other.exponent_;
 
-    while (exponent_ < e)
+    if (exponent_ < e)
     {
-        mantissa_ /= 10;
-        ++exponent_;
+        mantissa_ = dropDigits(mantissa_, e - exponent_);
+        exponent_ = e;
     }
-
-    while (e < exponent_)
+    else if (e < exponent_)
     {
-        m /= 10;
-        ++e;
+        m = dropDigits(m, exponent_ - e);
+        e = exponent_;
     }
 
     // This addition cannot overflow an std::int64_t but we may throw from
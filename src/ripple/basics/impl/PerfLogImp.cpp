@@ -71,6 +71,85 @@ PerfLogImp::Counters::Counters(
     }
 }
 
+std::size_t
+PerfLogImp::Counters::Histogram::bucket(std::uint64_t us)
+{
+    if (us < subBuckets)
+        return us;
+
+    // The position of the highest set bit selects the power of two, and the
+    // two bits below it select the sub-bucket.
+    std::size_t exponent = 0;
+    for (auto v = us; v >>= 1;)
+        ++exponent;
+
+    auto const sub = (us >> (exponent - 2)) & (subBuckets - 1);
+    return std::min((exponent - 1) * subBuckets + sub, buckets - 1);
+}
+
+std::uint64_t
+PerfLogImp::Counters::Histogram::upperBound(std::size_t bucket)
+{
+    if (bucket < subBuckets)
+        return bucket;
+
+    auto const exponent = bucket / subBuckets + 1;
+    auto const sub = bucket % subBuckets;
+    std::uint64_t const width = std::uint64_t{1} << (exponent - 2);
+    return (subBuckets + sub) * width + width - 1;
+}
+
+void
+PerfLogImp::Counters::Histogram::record(microseconds dur)
+{
+    auto const us = std::max<microseconds::rep>(dur.count(), 0);
+    counts_[bucket(us)].fetch_add(1, std::memory_order_relaxed);
+}
+
+Json::Value
+PerfLogImp::Counters::Histogram::json() const
+{
+    std::array<std::uint64_t, buckets> counts;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    if (!total)
+        return Json::nullValue;
+
+    Json::Value ret(Json::objectValue);
+    ret[jss::count] = std::to_string(total);
+
+    // Percentiles in tenths of a percent, so that 99.9 can be expressed.
+    static std::array<std::pair<char const*, std::uint64_t>, 4> const
+        percentiles{
+            {{"p50", 500}, {"p90", 900}, {"p99", 990}, {"p999", 999}}};
+
+    std::uint64_t seen = 0;
+    std::size_t i = 0;
+    for (auto const& [name, permille] : percentiles)
+    {
+        // The smallest rank at or above the requested percentile.
+        auto const rank = std::max<std::uint64_t>(
+            (total * permille + 999) / 1000, 1);
+        while (seen + counts[i] < rank)
+            seen += counts[i++];
+        ret[name] = std::to_string(upperBound(i));
+    }
+
+    std::size_t last = buckets - 1;
+    while (!counts[last])
+        --last;
+    ret["max"] = std::to_string(upperBound(last));
+
+    return ret;
+}
+
+//-----------------------------------------------------------------------------
+
 Json::Value
 PerfLogImp::Counters::countersJson() const
 {
@@ -227,6 +306,38 @@ PerfLogImp::Counters::currentJson() const
     return current;
 }
 
+Json::Value
+PerfLogImp::Counters::latencyJson() const
+{
+    Json::Value rpcobj(Json::objectValue);
+    for (auto const& proc : rpc_)
+    {
+        auto duration = proc.second.duration.json();
+        if (!duration.isNull())
+            rpcobj[proc.first][jss::duration_us] = std::move(duration);
+    }
+
+    Json::Value jqobj(Json::objectValue);
+    for (auto const& proc : jq_)
+    {
+        auto queued = proc.second.queued.json();
+        auto running = proc.second.running.json();
+        if (queued.isNull() && running.isNull())
+            continue;
+
+        Json::Value& j = jqobj[proc.second.label];
+        if (!queued.isNull())
+            j[jss::queued_duration_us] = std::move(queued);
+        if (!running.isNull())
+            j[jss::running_duration_us] = std::move(running);
+    }
+
+    Json::Value latency(Json::objectValue);
+    latency[jss::rpc] = rpcobj;
+    latency[jss::job_queue] = jqobj;
+    return latency;
+}
+
 //-----------------------------------------------------------------------------
 
 void
@@ -307,6 +418,7 @@ PerfLogImp::report()
     report[jss::counters] = counters_.countersJson();
     auto cur = counters_.currentJson();
     report[jss::current_activities] = counters_.currentJson();
+    report[jss::latency] = counters_.latencyJson();
 
     logFile_ << Json::Compact{std::move(report)} << std::endl;
 }
@@ -374,13 +486,15 @@ PerfLogImp::rpcEnd(
             assert(false);
         }
     }
+    auto const duration = std::chrono::duration_cast<microseconds>(
+        steady_clock::now() - startTime);
+    counter->second.duration.record(duration);
     std::lock_guard lock(counter->second.mut);
     if (finish)
         ++counter->second.sync.finished;
     else
         ++counter->second.sync.errored;
-    counter->second.sync.duration += std::chrono::duration_cast<microseconds>(
-        steady_clock::now() - startTime);
+    counter->second.sync.duration += duration;
 }
 
 void
@@ -409,6 +523,7 @@ PerfLogImp::jobStart(
         assert(false);
         return;
     }
+    counter->second.queued.record(dur);
     {
         std::lock_guard lock(counter->second.mut);
         ++counter->second.sync.started;
@@ -428,6 +543,7 @@ PerfLogImp::jobFinish(JobType const type, microseconds dur, int instance)
         assert(false);
         return;
     }
+    counter->second.running.record(dur);
     {
         std::lock_guard lock(counter->second.mut);
         ++counter->second.sync.finished;
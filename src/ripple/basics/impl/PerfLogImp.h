@@ -27,6 +27,8 @@
 #include <ripple/protocol/jss.h>
 #include <ripple/rpc/impl/Handler.h>
 #include <boost/asio/ip/host_name.hpp>
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <fstream>
@@ -54,6 +56,40 @@ class PerfLogImp : public PerfLog, Stoppable
     {
     public:
         using MethodStart = std::pair<char const*, steady_time_point>;
+
+        /**
+         * Latency histogram.
+         *
+         * Each power of two microseconds is split into four buckets, so
+         * a reported percentile is at most 25% above the true value.
+         * Recording is one relaxed atomic increment and takes no lock.
+         */
+        class Histogram
+        {
+            static constexpr std::size_t subBuckets = 4;
+            static constexpr std::size_t buckets = 160;
+
+            std::array<std::atomic<std::uint64_t>, buckets> counts_{};
+
+            static std::size_t
+            bucket(std::uint64_t us);
+
+            // The largest duration, in microseconds, counted by a bucket.
+            static std::uint64_t
+            upperBound(std::size_t bucket);
+
+        public:
+            Histogram() = default;
+
+            void
+            record(microseconds dur);
+
+            // Renders the count and percentiles of the recorded durations,
+            // or null if nothing was recorded.
+            Json::Value
+            json() const;
+        };
+
         /**
          * RPC performance counters.
          */
@@ -74,6 +110,7 @@ class PerfLogImp : public PerfLog, Stoppable
 
             Sync sync;
             mutable std::mutex mut;
+            Histogram duration;
 
             Rpc() = default;
 
@@ -104,6 +141,8 @@ class PerfLogImp : public PerfLog, Stoppable
             Sync sync;
             std::string const label;
             mutable std::mutex mut;
+            Histogram queued;
+            Histogram running;
 
             Jq(std::string const& labelArg) : label(labelArg)
             {
@@ -131,6 +170,8 @@ class PerfLogImp : public PerfLog, Stoppable
         countersJson() const;
         Json::Value
         currentJson() const;
+        Json::Value
+        latencyJson() const;
     };
 
     Setup const setup_;
@@ -199,6 +240,12 @@ public:
         return counters_.countersJson();
     }
 
+    Json::Value
+    latencyJson() const override
+    {
+        return counters_.latencyJson();
+    }
+
     Json::Value
     currentJson() const override
     {
@@ -164,6 +164,9 @@ public:
     std::uint32_t LEDGER_HISTORY = 256;
     std::uint32_t FETCH_DEPTH = 1000000000;
 
+    // Number of published ledgers whose state changes are kept in memory
+    std::uint32_t STATE_DELTA_LOG = 0;
+
     std::size_t NODE_SIZE = 0;
 
     bool SSL_VERIFY = true;
@@ -173,6 +176,18 @@ public:
     // Compression
     bool COMPRESSION = false;
 
+    // Validation/proposal reduce-relay: squelch redundant relaying of
+    // trusted validators' messages by peers which support the feature.
+    bool VP_REDUCE_RELAY_ENABLE = false;
+
+    // Transaction reduce-relay: relay full transactions to a subset of the
+    // peers which support the feature and announce hashes to the rest.
+    bool TX_REDUCE_RELAY_ENABLE = false;
+    // Minimum number of peers a transaction is relayed to in full
+    std::size_t TX_REDUCE_RELAY_MIN_PEERS = 20;
+    // Percentage of active peers a transaction is relayed to in full
+    std::size_t TX_RELAY_PERCENTAGE = 25;
+
     // Amendment majority time
     std::chrono::seconds AMENDMENT_MAJORITY_TIME = defaultAmendmentMajorityTime;
 
@@ -38,6 +38,7 @@ enum JobType {
     // earlier jobs having lower priority than later jobs. If you wish to
     // insert a job at a specific priority, simply add it at the right location.
 
+    jtREPLAY,         // Replay a ledger to check its history
     jtPACK,           // Make a fetch pack for a peer
     jtPUBOLDLEDGER,   // An old ledger has been accepted
     jtVALIDATION_ut,  // A validation from an untrusted source
@@ -135,7 +136,6 @@ public:
     rename(std::string const& n);
 
     // These comparison operators make the jobs sort in priority order
-    // in the job set
     bool
     operator<(const Job& j) const;
     bool
@@ -236,7 +236,9 @@ private:
     beast::Journal m_journal;
     mutable std::mutex m_mutex;
     std::uint64_t m_lastJob;
-    std::set<Job> m_jobSet;
+    // The number of jobs waiting across all types. The jobs themselves are
+    // queued by type in m_jobData.
+    std::size_t m_jobCount;
     JobDataMap m_jobData;
     JobTypeData m_invalidJobData;
 
@@ -283,11 +285,10 @@ private:
         std::string const& name,
         JobFunction const& func);
 
-    // Signals an added Job for processing.
+    // Adds a Job to the queue of its type and signals it for processing.
     //
     // Pre-conditions:
     //  The JobType must be valid.
-    //  The Job must exist in mJobSet.
     //  The Job must not have previously been queued.
     //
     // Post-conditions:
@@ -298,20 +299,21 @@ private:
     // Invariants:
     //  The calling thread owns the JobLock
     void
-    queueJob(Job const& job, std::lock_guard<std::mutex> const& lock);
+    queueJob(Job&& job, std::lock_guard<std::mutex> const& lock);
 
     // Returns the next Job we should run now.
     //
     // RunnableJob:
-    //  A Job in the JobSet whose slots count for its type is greater than zero.
+    //  The oldest waiting Job of the highest priority type whose slots count
+    //  is greater than zero.
     //
     // Pre-conditions:
-    //  mJobSet must not be empty.
-    //  mJobSet holds at least one RunnableJob
+    //  At least one Job is waiting.
+    //  At least one RunnableJob exists.
     //
     // Post-conditions:
     //  job is a valid Job object.
-    //  job is removed from mJobQueue.
+    //  job is removed from the queue of its type.
     //  Waiting job count of its type is decremented
     //  Running job count of its type is incremented
     //
@@ -323,7 +325,7 @@ private:
     // Indicates that a running Job has completed its task.
     //
     // Pre-conditions:
-    //  Job must not exist in mJobSet.
+    //  Job must not be waiting in the queue of its type.
     //  The JobType must not be invalid.
     //
     // Post-conditions:
@@ -339,7 +341,7 @@ private:
     // Runs the next appropriate waiting Job.
     //
     // Pre-conditions:
-    //  A RunnableJob must exist in the JobSet
+    //  A RunnableJob must be waiting
     //
     // Post-conditions:
     //  The chosen RunnableJob will have Job::doJob() called.
@@ -22,7 +22,10 @@
 
 #include <ripple/basics/Log.h>
 #include <ripple/beast/insight/Collector.h>
+#include <ripple/core/Job.h>
 #include <ripple/core/JobTypeInfo.h>
+#include <atomic>
+#include <deque>
 
 namespace ripple {
 
@@ -38,11 +41,16 @@ public:
     /* The job category which we represent */
     JobTypeInfo const& info;
 
-    /* The number of jobs waiting */
-    int waiting;
+    /* The jobs waiting, in the order they were added */
+    std::deque<Job> jobs;
 
-    /* The number presently running */
-    int running;
+    /* The number of jobs waiting. Only changed under the JobQueue lock, but
+       may be read without it. */
+    std::atomic<int> waiting;
+
+    /* The number presently running. Only changed under the JobQueue lock, but
+       may be read without it. */
+    std::atomic<int> running;
 
     /* And the number we deferred executing because of job limits */
     int deferred;
@@ -463,6 +463,9 @@ Config::loadFromString(std::string const& fileContents)
             FETCH_DEPTH = 10;
     }
 
+    if (getSingleSection(secConfig, SECTION_STATE_DELTA_LOG, strTemp, j_))
+        STATE_DELTA_LOG = beast::lexicalCastThrow<std::uint32_t>(strTemp);
+
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH_OLD, strTemp, j_))
         PATH_SEARCH_OLD = beast::lexicalCastThrow<int>(strTemp);
     if (getSingleSection(secConfig, SECTION_PATH_SEARCH, strTemp, j_))
@@ -481,6 +484,22 @@ Config::loadFromString(std::string const& fileContents)
     if (getSingleSection(secConfig, SECTION_COMPRESSION, strTemp, j_))
         COMPRESSION = beast::lexicalCastThrow<bool>(strTemp);
 
+    {
+        auto const& sec = section(SECTION_REDUCE_RELAY);
+        VP_REDUCE_RELAY_ENABLE = sec.value_or("vp_enable", false);
+        TX_REDUCE_RELAY_ENABLE = sec.value_or("tx_enable", false);
+        TX_REDUCE_RELAY_MIN_PEERS =
+            sec.value_or<std::size_t>("tx_min_peers", 20);
+        TX_RELAY_PERCENTAGE =
+            sec.value_or<std::size_t>("tx_relay_percentage", 25);
+        if (TX_RELAY_PERCENTAGE < 10 || TX_RELAY_PERCENTAGE > 100 ||
+            TX_REDUCE_RELAY_MIN_PEERS < 10)
+            Throw<std::runtime_error>(
+                "Invalid " SECTION_REDUCE_RELAY
+                ", tx_min_peers must be greater or equal to 10"
+                ", tx_relay_percentage must be between 10 and 100");
+    }
+
     if (getSingleSection(
             secConfig, SECTION_AMENDMENT_MAJORITY_TIME, strTemp, j_))
     {
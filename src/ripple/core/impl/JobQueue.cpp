@@ -32,6 +32,7 @@ JobQueue::JobQueue(
     : Stoppable("JobQueue", parent)
     , m_journal(journal)
     , m_lastJob(0)
+    , m_jobCount(0)
     , m_invalidJobData(JobTypes::instance().getInvalid(), collector, logs)
     , m_processCount(0)
     , m_workers(*this, &perfLog, "JobQueue", 0)
@@ -70,7 +71,7 @@ void
 JobQueue::collect()
 {
     std::lock_guard lock(m_mutex);
-    job_count = m_jobSet.size();
+    job_count = m_jobCount;
 }
 
 bool
@@ -108,11 +109,11 @@ JobQueue::addRefCountedJob(
         //
         assert(
             !isStopped() &&
-            (m_processCount > 0 || !m_jobSet.empty() || !areChildrenStopped()));
+            (m_processCount > 0 || m_jobCount != 0 || !areChildrenStopped()));
 
-        std::pair<std::set<Job>::iterator, bool> result(m_jobSet.insert(
-            Job(type, name, ++m_lastJob, data.load(), func, m_cancelCallback)));
-        queueJob(*result.first, lock);
+        queueJob(
+            Job(type, name, ++m_lastJob, data.load(), func, m_cancelCallback),
+            lock);
     }
     return true;
 }
@@ -120,18 +121,16 @@ JobQueue::addRefCountedJob(
 int
 JobQueue::getJobCount(JobType t) const
 {
-    std::lock_guard lock(m_mutex);
-
+    // The map is never changed after construction and the counts are atomic,
+    // so callers on the overlay and RPC threads need not take the lock.
     JobDataMap::const_iterator c = m_jobData.find(t);
 
-    return (c == m_jobData.end()) ? 0 : c->second.waiting;
+    return (c == m_jobData.end()) ? 0 : c->second.waiting.load();
 }
 
 int
 JobQueue::getJobCountTotal(JobType t) const
 {
-    std::lock_guard lock(m_mutex);
-
     JobDataMap::const_iterator c = m_jobData.find(t);
 
     return (c == m_jobData.end()) ? 0 : (c->second.waiting + c->second.running);
@@ -143,8 +142,6 @@ JobQueue::getJobCountGE(JobType t) const
     // return the number of jobs at this priority level or greater
     int ret = 0;
 
-    std::lock_guard lock(m_mutex);
-
     for (auto const& x : m_jobData)
     {
         if (x.first >= t)
@@ -276,7 +273,7 @@ void
 JobQueue::rendezvous()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    cv_.wait(lock, [&] { return m_processCount == 0 && m_jobSet.empty(); });
+    cv_.wait(lock, [&] { return m_processCount == 0 && m_jobCount == 0; });
 }
 
 JobTypeData&
@@ -312,23 +309,24 @@ JobQueue::checkStopped(std::lock_guard<std::mutex> const& lock)
     //  5. There are no suspended coroutines
     //
     if (isStopping() && areChildrenStopped() && (m_processCount == 0) &&
-        m_jobSet.empty() && nSuspend_ == 0)
+        m_jobCount == 0 && nSuspend_ == 0)
     {
         stopped();
     }
 }
 
 void
-JobQueue::queueJob(Job const& job, std::lock_guard<std::mutex> const& lock)
+JobQueue::queueJob(Job&& job, std::lock_guard<std::mutex> const& lock)
 {
     JobType const type(job.getType());
     assert(type != jtINVALID);
-    assert(m_jobSet.find(job) != m_jobSet.end());
     perfLog_.jobQueue(type);
 
     JobTypeData& data(getJobTypeData(type));
+    data.jobs.push_back(std::move(job));
+    ++m_jobCount;
 
-    if (data.waiting + data.running < getJobLimit(type))
+    if (data.waiting + data.running < data.info.limit())
     {
         m_workers.addTask();
     }
@@ -344,32 +342,35 @@ JobQueue::queueJob(Job const& job, std::lock_guard<std::mutex> const& lock)
 void
 JobQueue::getNextJob(Job& job)
 {
-    assert(!m_jobSet.empty());
+    assert(m_jobCount != 0);
 
-    std::set<Job>::const_iterator iter;
-    for (iter = m_jobSet.begin(); iter != m_jobSet.end(); ++iter)
+    // Job types are in increasing order of priority. Within a type, jobs
+    // run in the order they were added, so only the front of each type's
+    // queue needs to be considered.
+    auto iter = m_jobData.rbegin();
+    for (; iter != m_jobData.rend(); ++iter)
     {
-        JobTypeData& data(getJobTypeData(iter->getType()));
+        JobTypeData& data(iter->second);
 
-        assert(data.running <= getJobLimit(data.type()));
+        assert(data.running <= data.info.limit());
 
         // Run this job if we're running below the limit.
-        if (data.running < getJobLimit(data.type()))
+        if (!data.jobs.empty() && data.running < data.info.limit())
         {
             assert(data.waiting > 0);
             break;
         }
     }
 
-    assert(iter != m_jobSet.end());
+    assert(iter != m_jobData.rend());
 
-    JobType const type = iter->getType();
-    JobTypeData& data(getJobTypeData(type));
+    JobTypeData& data(iter->second);
 
-    assert(type != jtINVALID);
+    assert(data.type() != jtINVALID);
 
-    job = *iter;
-    m_jobSet.erase(iter);
+    job = std::move(data.jobs.front());
+    data.jobs.pop_front();
+    --m_jobCount;
 
     --data.waiting;
     ++data.running;
@@ -439,7 +440,7 @@ JobQueue::processTask(int instance)
         // otherwise destructors with side effects can access
         // parent objects that are already destroyed.
         finishJob(type);
-        if (--m_processCount == 0 && m_jobSet.empty())
+        if (--m_processCount == 0 && m_jobCount == 0)
             cv_.notify_all();
         checkStopped(lock);
     }
@@ -21,12 +21,14 @@
 #define RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 
 #include <ripple/basics/XRPAmount.h>
+#include <ripple/basics/qalloc.h>
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/ledger/OpenView.h>
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/ledger/TxMeta.h>
 #include <ripple/protocol/TER.h>
+#include <boost/container/flat_map.hpp>
 #include <memory>
 
 namespace ripple {
@@ -46,7 +48,27 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
+public:
+    /** The arena a table allocates its bookkeeping from.
+
+        Everything a table allocates is released together when the
+        table and the views stacked on it are gone, which is at the
+        end of the transaction that created it.
+    */
+    using allocator_type = qalloc_type<int, false>;
+
+private:
+    // A transaction touches at most a few hundred entries, and they are
+    // looked up far more often than they are added. A sorted vector keeps
+    // the keys contiguous and costs no allocation per entry.
+    using value_type =
+        std::pair<key_type, std::pair<Action, std::shared_ptr<SLE>>>;
+
+    using items_t = boost::container::flat_map<
+        key_type,
+        std::pair<Action, std::shared_ptr<SLE>>,
+        std::less<key_type>,
+        qalloc_type<value_type, false>>;
 
     items_t items_;
     XRPAmount dropsDestroyed_{0};
@@ -55,6 +77,8 @@ public:
     ApplyStateTable() = default;
     ApplyStateTable(ApplyStateTable&&) = default;
 
+    explicit ApplyStateTable(allocator_type const& alloc);
+
     ApplyStateTable(ApplyStateTable const&) = delete;
     ApplyStateTable&
     operator=(ApplyStateTable&&) = delete;
@@ -118,6 +142,12 @@ public:
     void
     destroyXRP(XRPAmount const& fee);
 
+    allocator_type
+    get_allocator() const
+    {
+        return items_.get_allocator();
+    }
+
     // For debugging
     XRPAmount const&
     dropsDestroyed() const
@@ -126,7 +156,12 @@ public:
     }
 
 private:
-    using Mods = hash_map<key_type, std::shared_ptr<SLE>>;
+    using Mods = hash_map<
+        key_type,
+        std::shared_ptr<SLE>,
+        beast::uhash<>,
+        std::equal_to<key_type>,
+        qalloc_type<std::pair<key_type const, std::shared_ptr<SLE>>, false>>;
 
     static void
     threadItem(TxMeta& meta, std::shared_ptr<SLE> const& to);
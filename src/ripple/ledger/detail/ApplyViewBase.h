@@ -120,6 +120,13 @@ public:
     void
     rawDestroyXRP(XRPAmount const& feeDrops) override;
 
+    /** Returns the arena this view tracks its changes in. */
+    ApplyStateTable::allocator_type
+    arena() const
+    {
+        return items_.get_allocator();
+    }
+
     friend CashDiff
     cashFlowDiff(
         CashFilter lhsFilter,
@@ -27,6 +27,11 @@
 namespace ripple {
 namespace detail {
 
+ApplyStateTable::ApplyStateTable(allocator_type const& alloc)
+    : items_(items_t::allocator_type(alloc))
+{
+}
+
 void
 ApplyStateTable::apply(RawView& to) const
 {
@@ -131,7 +136,7 @@ ApplyStateTable::apply(
         if (!hookExecution.empty())
             meta.setHookExecutions(STArray{hookExecution, sfHookExecutions});
 
-        Mods newMod;
+        Mods newMod(Mods::allocator_type(items_.get_allocator()));
         for (auto& item : items_)
         {
             SField const* type;
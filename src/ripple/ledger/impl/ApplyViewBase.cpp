@@ -24,8 +24,18 @@
 namespace ripple {
 namespace detail {
 
+// A view stacked on another ApplyViewBase is a sandbox used while
+// applying the same transaction, so it shares the parent's arena.
+static ApplyStateTable::allocator_type
+arenaFor(ReadView const* base)
+{
+    if (auto const parent = dynamic_cast<ApplyViewBase const*>(base))
+        return parent->arena();
+    return {};
+}
+
 ApplyViewBase::ApplyViewBase(ReadView const* base, ApplyFlags flags)
-    : flags_(flags), base_(base)
+    : flags_(flags), base_(base), items_(arenaFor(base))
 {
 }
 
@@ -26,7 +26,12 @@
 #include <ripple/json/json_value.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/resource/Consumer.h>
+#include <boost/optional.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace ripple {
 
@@ -35,6 +40,53 @@ namespace ripple {
 
 class PathRequest;
 
+/** A JSON message published to many subscribers.
+
+    The message is serialized the first time a subscriber asks for its
+    text, and the resulting immutable buffer is shared by every other
+    subscriber instead of being serialized once per subscriber. Not
+    thread safe: publishing loops use it from a single thread.
+
+    A message may also carry a binary form, in which serialized objects
+    are sent as hex blobs. Both forms may be built on demand so that a
+    form no subscriber asked for is never generated. When a message has
+    no binary form, binary subscribers receive the JSON form.
+*/
+class PublishedJson
+{
+public:
+    using Factory = std::function<Json::Value()>;
+
+    explicit PublishedJson(Json::Value const& jv);
+
+    PublishedJson(Factory json, Factory binary);
+
+    PublishedJson(PublishedJson const&) = delete;
+    PublishedJson&
+    operator=(PublishedJson const&) = delete;
+
+    Json::Value const&
+    json(bool binary = false);
+
+    /** Returns the compact serialized text of the message. */
+    std::shared_ptr<std::string const> const&
+    text(bool binary = false);
+
+private:
+    struct Form
+    {
+        Factory make;
+        Json::Value const* jv = nullptr;
+        boost::optional<Json::Value> value;
+        std::shared_ptr<std::string const> text;
+    };
+
+    Form&
+    form(bool binary);
+
+    Form forms_[2];
+};
+
 /** Manages a client's subscription to data feeds.
  */
 class InfoSub : public CountedObject<InfoSub>
@@ -164,6 +216,31 @@ public:
     virtual void
     send(Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message which is published to many subscribers.
+
+        By default the JSON object is sent, in binary form if the
+        subscriber asked for it. Subscribers which write the message as
+        text override this to share its serialized form.
+    */
+    virtual void
+    send(PublishedJson& msg, bool broadcast)
+    {
+        send(msg.json(isBinary()), broadcast);
+    }
+
+    /** Whether transactions are published to this subscriber as blobs. */
+    bool
+    isBinary() const
+    {
+        return binary_;
+    }
+
+    void
+    setBinary(bool binary)
+    {
+        binary_ = binary;
+    }
+
     std::uint64_t
     getSeq();
 
@@ -195,6 +272,7 @@ private:
     hash_set<AccountID> normalSubscriptions_;
     std::shared_ptr<PathRequest> mPathRequest;
     std::uint64_t mSeq;
+    std::atomic<bool> binary_{false};
 
     static int
     assign_id()
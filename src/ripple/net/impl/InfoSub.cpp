@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include <ripple/json/json_writer.h>
 #include <ripple/net/InfoSub.h>
 #include <atomic>
 
@@ -35,6 +36,54 @@ namespace ripple {
 
 //------------------------------------------------------------------------------
 
+PublishedJson::PublishedJson(Json::Value const& jv)
+{
+    forms_[0].jv = &jv;
+}
+
+PublishedJson::PublishedJson(Factory json, Factory binary)
+{
+    forms_[0].make = std::move(json);
+    forms_[1].make = std::move(binary);
+}
+
+PublishedJson::Form&
+PublishedJson::form(bool binary)
+{
+    if (binary && (forms_[1].jv || forms_[1].make))
+        return forms_[1];
+    return forms_[0];
+}
+
+Json::Value const&
+PublishedJson::json(bool binary)
+{
+    auto& f = form(binary);
+    if (!f.jv)
+    {
+        f.value.emplace(f.make());
+        f.jv = &*f.value;
+    }
+    return *f.jv;
+}
+
+std::shared_ptr<std::string const> const&
+PublishedJson::text(bool binary)
+{
+    auto& f = form(binary);
+    if (!f.text)
+    {
+        auto text = std::make_shared<std::string>();
+        Json::stream(json(binary), [&text](void const* data, std::size_t n) {
+            text->append(static_cast<char const*>(data), n);
+        });
+        f.text = std::move(text);
+    }
+    return f.text;
+}
+
+//------------------------------------------------------------------------------
+
 InfoSub::Source::Source(char const* name, Stoppable& parent)
     : Stoppable(name, parent)
 {
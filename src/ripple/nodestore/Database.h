@@ -29,6 +29,8 @@
 #include <ripple/nodestore/impl/Tuning.h>
 #include <ripple/protocol/SystemParameters.h>
 
+#include <deque>
+#include <exception>
 #include <thread>
 
 namespace ripple {
@@ -158,6 +160,22 @@ public:
     void
     waitReads();
 
+    /** Fetch several objects at once.
+
+        The objects are read in key order, in parallel, by the async read
+        threads and the calling thread together. Pending async reads of the
+        same objects are taken over by the batch. Unlike waitReads, this
+        waits only for the objects requested.
+
+        @note This can be called concurrently.
+        @param hashes The keys of the objects to retrieve.
+        @param seq The sequence of the ledger where the objects are stored.
+        @return The objects, in the same order as the keys. An object that
+                couldn't be retrieved is nullptr.
+    */
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch(std::vector<uint256> const& hashes, std::uint32_t seq);
+
     /** Get the maximum number of async reads the node store prefers.
 
         @param seq A ledger sequence specifying a shard to query.
@@ -309,6 +327,27 @@ private:
     // last read
     uint256 readLastHash_;
 
+    // A call to fetchBatch in progress
+    struct BatchRead
+    {
+        std::vector<uint256> const& hashes;
+        std::uint32_t const seq;
+        std::vector<std::shared_ptr<NodeObject>>& objects;
+
+        // Indexes into hashes, in key order
+        std::vector<std::size_t> order;
+
+        // The next entry in order to read, and the number of reads done
+        std::size_t next = 0;
+        std::size_t done = 0;
+
+        std::exception_ptr error;
+    };
+
+    // batches with reads nobody has started yet
+    std::deque<BatchRead*> batches_;
+    std::condition_variable batchCondVar_;
+
     std::vector<std::thread> readThreads_;
     bool readShut_{false};
 
@@ -332,6 +371,10 @@ private:
     virtual void
     for_each(std::function<void(std::shared_ptr<NodeObject>)> f) = 0;
 
+    // Perform the next read of a batch, releasing the lock while reading
+    void
+    readBatchEntry(std::unique_lock<std::mutex>& lock, BatchRead& batch);
+
     void
     threadEntry();
 };
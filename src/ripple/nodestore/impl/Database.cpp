@@ -22,6 +22,8 @@
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/nodestore/Database.h>
 #include <ripple/protocol/HashPrefix.h>
+#include <algorithm>
+#include <numeric>
 
 namespace ripple {
 namespace NodeStore {
@@ -119,6 +121,44 @@ Database::asyncFetch(
         readCondVar_.notify_one();
 }
 
+std::vector<std::shared_ptr<NodeObject>>
+Database::fetchBatch(std::vector<uint256> const& hashes, std::uint32_t seq)
+{
+    std::vector<std::shared_ptr<NodeObject>> objects(hashes.size());
+    if (hashes.empty())
+        return objects;
+
+    BatchRead batch{hashes, seq, objects};
+    batch.order.resize(hashes.size());
+    std::iota(batch.order.begin(), batch.order.end(), std::size_t{0});
+    // Read in key order to make the back end more efficient
+    std::sort(
+        batch.order.begin(),
+        batch.order.end(),
+        [&hashes](std::size_t lhs, std::size_t rhs) {
+            return hashes[lhs] < hashes[rhs];
+        });
+
+    std::unique_lock<std::mutex> lock(readLock_);
+
+    // The batch reads these itself
+    for (auto const& hash : hashes)
+        read_.erase(hash);
+
+    batches_.push_back(&batch);
+    readCondVar_.notify_all();
+
+    // Do our share rather than just waiting
+    while (batch.next < hashes.size())
+        readBatchEntry(lock, batch);
+
+    batchCondVar_.wait(lock, [&] { return batch.done == hashes.size(); });
+
+    if (batch.error)
+        std::rethrow_exception(batch.error);
+    return objects;
+}
+
 std::shared_ptr<NodeObject>
 Database::fetchInternal(uint256 const& hash, std::shared_ptr<Backend> backend)
 {
@@ -335,6 +375,36 @@ Database::storeLedger(
     return true;
 }
 
+void
+Database::readBatchEntry(std::unique_lock<std::mutex>& lock, BatchRead& batch)
+{
+    assert(batch.next < batch.hashes.size());
+    auto const index = batch.order[batch.next++];
+
+    // Once every read has been started, nobody else needs to see the batch
+    if (batch.next == batch.hashes.size())
+        batches_.erase(std::find(batches_.begin(), batches_.end(), &batch));
+
+    std::shared_ptr<NodeObject> object;
+    std::exception_ptr error;
+    lock.unlock();
+    try
+    {
+        object = fetch(batch.hashes[index], batch.seq);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    lock.lock();
+
+    batch.objects[index] = std::move(object);
+    if (error && !batch.error)
+        batch.error = error;
+    if (++batch.done == batch.hashes.size())
+        batchCondVar_.notify_all();
+}
+
 // Entry point for async read threads
 void
 Database::threadEntry()
@@ -348,7 +418,7 @@ Database::threadEntry()
         std::shared_ptr<KeyCache<uint256>> lastNcache;
         {
             std::unique_lock<std::mutex> lock(readLock_);
-            while (!readShut_ && read_.empty())
+            while (!readShut_ && read_.empty() && batches_.empty())
             {
                 // All work is done
                 readGenCondVar_.notify_all();
@@ -357,6 +427,13 @@ Database::threadEntry()
             if (readShut_)
                 break;
 
+            // Someone is waiting on a batch, so it goes first
+            if (!batches_.empty())
+            {
+                readBatchEntry(lock, *batches_.front());
+                continue;
+            }
+
             // Read in key order to make the back end more efficient
             auto it = read_.lower_bound(readLastHash_);
             if (it == read_.end())
@@ -36,6 +36,7 @@
 #include <boost/optional.hpp>
 #include <functional>
 #include <memory>
+#include <set>
 #include <type_traits>
 
 namespace boost {
@@ -133,7 +134,7 @@ public:
 
     /** Returns the peer with the matching short id, or null. */
     virtual std::shared_ptr<Peer>
-    findPeerByShortID(Peer::id_t const& id) = 0;
+    findPeerByShortID(Peer::id_t const& id) const = 0;
 
     /** Returns the peer with the matching public key, or null. */
     virtual std::shared_ptr<Peer>
@@ -147,13 +148,45 @@ public:
     virtual void
     broadcast(protocol::TMValidation& m) = 0;
 
-    /** Relay a proposal. */
-    virtual void
-    relay(protocol::TMProposeSet& m, uint256 const& uid) = 0;
-
-    /** Relay a validation. */
+    /** Relay a proposal.
+     * @param m the serialized proposal
+     * @param uid the id used to identify this proposal
+     * @param validator The pubkey of the validator that issued this proposal
+     * @return the peers which already have the proposal, or an empty set if
+     *         it was not relayed
+     */
+    virtual std::set<Peer::id_t>
+    relay(
+        protocol::TMProposeSet& m,
+        uint256 const& uid,
+        PublicKey const& validator) = 0;
+
+    /** Relay a validation.
+     * @param m the serialized validation
+     * @param uid the id used to identify this validation
+     * @param validator The pubkey of the validator that issued this validation
+     * @return the peers which already have the validation, or an empty set if
+     *         it was not relayed
+     */
+    virtual std::set<Peer::id_t>
+    relay(
+        protocol::TMValidation& m,
+        uint256 const& uid,
+        PublicKey const& validator) = 0;
+
+    /** Relay a transaction. If transaction reduce-relay is enabled, the
+        full transaction is sent to a subset of the peers and the rest
+        only receive an announcement of its hash.
+
+        @param hash the transaction's id
+        @param m the transaction message
+        @param toSkip peers which already have the transaction
+    */
     virtual void
-    relay(protocol::TMValidation& m, uint256 const& uid) = 0;
+    relay(
+        uint256 const& hash,
+        protocol::TMTransaction& m,
+        std::set<Peer::id_t> const& toSkip) = 0;
 
     /** Visit every active peer.
      *
@@ -37,6 +37,8 @@ static constexpr std::uint32_t csHopLimit = 3;
 
 enum class ProtocolFeature {
     ValidatorListPropagation,
+    TxReduceRelay,
+    VpReduceRelay,
 };
 
 /** Represents a peer connection in the overlay. */
@@ -0,0 +1,648 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2020 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_SLOT_H_INCLUDED
+#define RIPPLE_OVERLAY_SLOT_H_INCLUDED
+
+#include <ripple/basics/Log.h>
+#include <ripple/basics/UnorderedContainers.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/basics/random.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/overlay/Peer.h>
+#include <ripple/overlay/SquelchCommon.h>
+#include <ripple/protocol/PublicKey.h>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <unordered_set>
+
+namespace ripple {
+
+namespace squelch {
+
+template <typename clock_type>
+class Slots;
+
+/** Peer's State */
+enum class PeerState : uint8_t {
+    Counting,   // counting messages
+    Selected,   // selected to relay, counting if Slot in Counting
+    Squelched,  // squelched, doesn't relay
+};
+/** Slot's State */
+enum class SlotState : uint8_t {
+    Counting,  // counting messages
+    Selected,  // peers selected, stop counting
+};
+
+/** Abstract class. Declares squelch and unsquelch handlers.
+    OverlayImpl inherits from this class. Motivation is
+    for easier unit tests to facilitate on the fly
+    changing callbacks. */
+class SquelchHandler
+{
+public:
+    virtual ~SquelchHandler() = default;
+
+    /** Squelch handler
+        @param validator Public key of the source validator
+        @param id Peer's id to squelch
+        @param duration Squelch duration in seconds
+     */
+    virtual void
+    squelch(PublicKey const& validator, Peer::id_t id, std::uint32_t duration)
+        const = 0;
+
+    /** Unsquelch handler
+        @param validator Public key of the source validator
+        @param id Peer's id to unsquelch
+     */
+    virtual void
+    unsquelch(PublicKey const& validator, Peer::id_t id) const = 0;
+};
+
+/**
+ * Slot is associated with a specific validator via validator's public key.
+ * Slot counts messages from a validator, selects peers to be the source
+ * of the messages, and communicates the peers to be squelched. Slot can be
+ * in the following states: 1) Counting. This is the peer selection state
+ * when Slot counts the messages and selects the peers; 2) Selected. Slot
+ * doesn't count messages in Selected state. A message received from
+ * unsquelched, disconnected peer, or idling peer may transition Slot to
+ * Counting state.
+ */
+template <typename clock_type>
+class Slot final
+{
+private:
+    friend class Slots<clock_type>;
+    using id_t = Peer::id_t;
+    using time_point = typename clock_type::time_point;
+
+    /** Constructor
+        @param handler Squelch/Unsquelch implementation
+        @param journal Journal for logging
+     */
+    Slot(SquelchHandler const& handler, beast::Journal journal)
+        : reachedThreshold_(0)
+        , lastSelected_(clock_type::now())
+        , state_(SlotState::Counting)
+        , handler_(handler)
+        , journal_(journal)
+    {
+    }
+
+    /** Update peer info. If the message is from a new
+        peer or from a previously expired squelched peer then switch
+        the peer's and slot's state to Counting. If time of last
+        selection round is > 2 * MAX_UNSQUELCH_EXPIRE then switch the slot's
+        state to Counting. If the number of messages for the peer
+        is > MIN_MESSAGE_THRESHOLD then add peer to considered peers pool.
+        If the number of considered peers who reached MAX_MESSAGE_THRESHOLD is
+        MAX_SELECTED_PEERS then randomly select MAX_SELECTED_PEERS from
+        considered peers, and call squelch handler for each peer, which is not
+        selected and not already in Squelched state. Set the state for those
+        peers to Squelched and reset the count of all peers. Set slot's state to
+        Selected. Message count is not updated when the slot is in Selected
+        state.
+        @param validator Public key of the source validator
+        @param id Peer id which received the message
+     */
+    void
+    update(PublicKey const& validator, id_t id);
+
+    /** Handle peer deletion when a peer disconnects.
+        If the peer is in Selected state then
+        call unsquelch handler for every peer in squelched state and reset
+        every peer's state to Counting. Switch Slot's state to Counting.
+        @param validator Public key of the source validator
+        @param id Deleted peer id
+        @param erase If true then erase the peer. The peer is not erased
+             when the peer when is idled. The peer is deleted when it
+             disconnects
+     */
+    void
+    deletePeer(PublicKey const& validator, id_t id, bool erase);
+
+    /** Check if peers stopped relaying messages. If a peer is
+        selected peer then call unsquelch handler for all
+        currently squelched peers and switch the slot to
+        Counting state.
+        @param validator Public key of the source validator
+     */
+    void
+    deleteIdlePeer(PublicKey const& validator);
+
+    /** Get the time of the last peer selection round */
+    time_point const&
+    getLastSelected() const
+    {
+        return lastSelected_;
+    }
+
+    /** Return number of peers in state */
+    std::uint16_t
+    inState(PeerState state) const;
+
+    /** Return selected peers */
+    std::set<id_t>
+    getSelected() const;
+
+    /** Get the slot's state */
+    SlotState
+    getState() const
+    {
+        return state_;
+    }
+
+private:
+    /** Reset counts of peers in Selected or Counting state */
+    void
+    resetCounts();
+
+    /** Initialize slot to Counting state */
+    void
+    initCounting();
+
+    /** Get random squelch duration between MIN_UNSQUELCH_EXPIRE and
+        min(max(MAX_UNSQUELCH_EXPIRE, SQUELCH_PER_PEER * npeers),
+            MAX_UNSQUELCH_EXPIRE_PEERS)
+        @param npeers number of peers that can be squelched in the Slot
+     */
+    std::chrono::seconds
+    getSquelchDuration(std::size_t npeers);
+
+    /** Data maintained for each peer */
+    struct PeerInfo
+    {
+        PeerState state;         // peer's state
+        std::size_t count;       // message count
+        time_point expire;       // squelch expiration time
+        time_point lastMessage;  // time last message received
+    };
+    hash_map<id_t, PeerInfo> peers_;  // peer's data
+    // pool of peers considered as the source of messages
+    // from validator - peers that reached MIN_MESSAGE_THRESHOLD
+    std::unordered_set<id_t> considered_;
+    // number of peers that reached MAX_MESSAGE_THRESHOLD
+    std::uint16_t reachedThreshold_;
+    // last time peers were selected, used to age the slot
+    time_point lastSelected_;
+    SlotState state_;                // slot's state
+    SquelchHandler const& handler_;  // squelch/unsquelch handler
+    beast::Journal const journal_;   // logging
+};
+
+template <typename clock_type>
+void
+Slot<clock_type>::deleteIdlePeer(PublicKey const& validator)
+{
+    auto now = clock_type::now();
+    for (auto it = peers_.begin(); it != peers_.end();)
+    {
+        auto& peer = it->second;
+        auto id = it->first;
+        ++it;
+        if (now - peer.lastMessage > IDLED)
+        {
+            JLOG(journal_.debug())
+                << "deleteIdlePeer: " << Slice(validator) << " " << id
+                << " idled "
+                << std::chrono::duration_cast<std::chrono::seconds>(
+                       now - peer.lastMessage)
+                       .count()
+                << " selected " << (peer.state == PeerState::Selected);
+            deletePeer(validator, id, false);
+        }
+    }
+}
+
+template <typename clock_type>
+void
+Slot<clock_type>::update(PublicKey const& validator, id_t id)
+{
+    using namespace std::chrono;
+    auto now = clock_type::now();
+    auto it = peers_.find(id);
+    // First message from this peer
+    if (it == peers_.end())
+    {
+        JLOG(journal_.debug())
+            << "update: adding peer " << Slice(validator) << " " << id;
+        peers_.emplace(
+            std::make_pair(id, PeerInfo{PeerState::Counting, 0, now, now}));
+        initCounting();
+        return;
+    }
+    // Message from a peer with expired squelch
+    if (it->second.state == PeerState::Squelched && now > it->second.expire)
+    {
+        JLOG(journal_.debug())
+            << "update: squelch expired " << Slice(validator) << " " << id;
+        it->second.state = PeerState::Counting;
+        it->second.lastMessage = now;
+        initCounting();
+        return;
+    }
+
+    auto& peer = it->second;
+
+    JLOG(journal_.trace())
+        << "update: existing peer " << Slice(validator) << " " << id
+        << " slot state " << static_cast<int>(state_) << " peer state "
+        << static_cast<int>(peer.state) << " count " << peer.count << " last "
+        << duration_cast<milliseconds>(now - peer.lastMessage).count()
+        << " pool " << considered_.size() << " threshold " << reachedThreshold_;
+
+    peer.lastMessage = now;
+
+    if (state_ != SlotState::Counting || peer.state == PeerState::Squelched)
+        return;
+
+    if (++peer.count > MIN_MESSAGE_THRESHOLD)
+        considered_.insert(id);
+    if (peer.count == (MAX_MESSAGE_THRESHOLD + 1))
+        ++reachedThreshold_;
+
+    if (now - lastSelected_ > 2 * MAX_UNSQUELCH_EXPIRE)
+    {
+        JLOG(journal_.debug())
+            << "update: resetting due to inactivity " << Slice(validator) << " "
+            << id << " " << duration_cast<seconds>(now - lastSelected_).count();
+        initCounting();
+        return;
+    }
+
+    if (reachedThreshold_ == MAX_SELECTED_PEERS)
+    {
+        // Randomly select MAX_SELECTED_PEERS peers from considered.
+        // Exclude peers that have been idling > IDLED -
+        // it's possible that deleteIdlePeer() has not been called yet.
+        // If number of remaining peers != MAX_SELECTED_PEERS
+        // then reset the Counting state and let deleteIdlePeer() handle
+        // idled peers.
+        std::unordered_set<id_t> selected;
+        auto const consideredPoolSize = considered_.size();
+        while (selected.size() != MAX_SELECTED_PEERS && considered_.size() != 0)
+        {
+            auto i =
+                considered_.size() == 1 ? 0 : rand_int(considered_.size() - 1);
+            auto it = std::next(considered_.begin(), i);
+            auto id = *it;
+            considered_.erase(it);
+            auto const& itpeers = peers_.find(id);
+            if (itpeers == peers_.end())
+            {
+                JLOG(journal_.error()) << "update: peer not found "
+                                       << Slice(validator) << " " << id;
+                continue;
+            }
+            if (now - itpeers->second.lastMessage < IDLED)
+                selected.insert(id);
+        }
+
+        if (selected.size() != MAX_SELECTED_PEERS)
+        {
+            JLOG(journal_.debug())
+                << "update: selection failed " << Slice(validator) << " " << id;
+            initCounting();
+            return;
+        }
+
+        lastSelected_ = now;
+
+        auto s = selected.begin();
+        JLOG(journal_.debug())
+            << "update: " << Slice(validator) << " " << id << " pool size "
+            << consideredPoolSize << " selected " << *s << " "
+            << *std::next(s, 1) << " " << *std::next(s, 2);
+
+        // squelch peers which are not selected and
+        // not already squelched
+        std::stringstream str;
+        for (auto& [k, v] : peers_)
+        {
+            v.count = 0;
+
+            if (selected.find(k) != selected.end())
+                v.state = PeerState::Selected;
+            else if (v.state != PeerState::Squelched)
+            {
+                if (journal_.debug())
+                    str << k << " ";
+                v.state = PeerState::Squelched;
+                auto duration =
+                    getSquelchDuration(peers_.size() - MAX_SELECTED_PEERS);
+                v.expire = now + duration;
+                handler_.squelch(validator, k, duration.count());
+            }
+        }
+        JLOG(journal_.debug()) << "update: squelching " << Slice(validator)
+                               << " " << id << " " << str.str();
+        considered_.clear();
+        reachedThreshold_ = 0;
+        state_ = SlotState::Selected;
+    }
+}
+
+template <typename clock_type>
+std::chrono::seconds
+Slot<clock_type>::getSquelchDuration(std::size_t npeers)
+{
+    using namespace std::chrono;
+    auto m = std::max(
+        MAX_UNSQUELCH_EXPIRE, seconds{SQUELCH_PER_PEER * npeers});
+    if (m > MAX_UNSQUELCH_EXPIRE_PEERS)
+    {
+        m = MAX_UNSQUELCH_EXPIRE_PEERS;
+        JLOG(journal_.warn())
+            << "getSquelchDuration: unexpected squelch duration " << npeers;
+    }
+    return seconds{ripple::rand_int(MIN_UNSQUELCH_EXPIRE / 1s, m / 1s)};
+}
+
+template <typename clock_type>
+void
+Slot<clock_type>::deletePeer(PublicKey const& validator, id_t id, bool erase)
+{
+    auto it = peers_.find(id);
+    if (it != peers_.end())
+    {
+        JLOG(journal_.debug())
+            << "deletePeer: " << Slice(validator) << " " << id << " selected "
+            << (it->second.state == PeerState::Selected) << " considered "
+            << (considered_.find(id) != considered_.end()) << " erase "
+            << erase;
+        auto now = clock_type::now();
+        if (it->second.state == PeerState::Selected)
+        {
+            for (auto& [k, v] : peers_)
+            {
+                if (v.state == PeerState::Squelched)
+                    handler_.unsquelch(validator, k);
+                v.state = PeerState::Counting;
+                v.count = 0;
+                v.expire = now;
+            }
+
+            considered_.clear();
+            reachedThreshold_ = 0;
+            state_ = SlotState::Counting;
+        }
+        else if (considered_.find(id) != considered_.end())
+        {
+            if (it->second.count > MAX_MESSAGE_THRESHOLD)
+                --reachedThreshold_;
+            considered_.erase(id);
+        }
+
+        it->second.lastMessage = now;
+        it->second.count = 0;
+
+        if (erase)
+            peers_.erase(it);
+    }
+}
+
+template <typename clock_type>
+void
+Slot<clock_type>::resetCounts()
+{
+    for (auto& [_, peer] : peers_)
+    {
+        (void)_;
+        peer.count = 0;
+    }
+}
+
+template <typename clock_type>
+void
+Slot<clock_type>::initCounting()
+{
+    state_ = SlotState::Counting;
+    considered_.clear();
+    reachedThreshold_ = 0;
+    resetCounts();
+}
+
+template <typename clock_type>
+std::uint16_t
+Slot<clock_type>::inState(PeerState state) const
+{
+    return std::count_if(peers_.begin(), peers_.end(), [&](auto const& it) {
+        return (it.second.state == state);
+    });
+}
+
+template <typename clock_type>
+std::set<Peer::id_t>
+Slot<clock_type>::getSelected() const
+{
+    std::set<id_t> init;
+    return std::accumulate(
+        peers_.begin(), peers_.end(), init, [](auto& init, auto const& it) {
+            if (it.second.state == PeerState::Selected)
+            {
+                init.insert(it.first);
+                return init;
+            }
+            return init;
+        });
+}
+
+/** Slots is a container for validator's Slot and handles Slot update
+    when a message is received from a validator. It also handles Slot aging
+    and checks for peers which are disconnected or stopped relaying the
+    messages. All access happens on the overlay's strand.
+ */
+template <typename clock_type>
+class Slots final
+{
+    using time_point = typename clock_type::time_point;
+    using id_t = Peer::id_t;
+
+public:
+    /**
+     * @param handler Squelch/unsquelch implementation
+     * @param journal Journal for logging
+     */
+    Slots(SquelchHandler const& handler, beast::Journal journal)
+        : handler_(handler), journal_(journal)
+    {
+    }
+    ~Slots() = default;
+
+    /** Calls Slot::update of Slot associated with the validator, unless
+        the peer already sent the message.
+        @param key Message's hash
+        @param validator Validator's public key
+        @param id Peer's id which received the message
+     */
+    void
+    updateSlotAndSquelch(
+        uint256 const& key,
+        PublicKey const& validator,
+        id_t id);
+
+    /** Check if peers stopped relaying messages
+        and if slots stopped receiving messages from the validator.
+     */
+    void
+    deleteIdlePeers();
+
+    /** Called when a peer is deleted. If the peer was selected to be the
+        source of messages from the validator then squelched peers have to be
+        unsquelched.
+        @param id Peer's id
+        @param erase If true then erase the peer
+     */
+    void
+    deletePeer(id_t id, bool erase);
+
+    /** Check if reduce-relay feature is ready. The server waits
+        WAIT_ON_BOOTUP after starting to let the peer connections settle.
+     */
+    bool
+    reduceRelayReady()
+    {
+        if (!reduceRelayReady_)
+            reduceRelayReady_ = clock_type::now() - startTime_ >=
+                WAIT_ON_BOOTUP;
+        return reduceRelayReady_;
+    }
+
+    /** Return number of peers in state */
+    boost::optional<std::uint16_t>
+    inState(PublicKey const& validator, PeerState state) const
+    {
+        auto const it = slots_.find(validator);
+        if (it != slots_.end())
+            return it->second.inState(state);
+        return {};
+    }
+
+    /** Get selected peers */
+    std::set<id_t>
+    getSelected(PublicKey const& validator)
+    {
+        auto const it = slots_.find(validator);
+        if (it != slots_.end())
+            return it->second.getSelected();
+        return {};
+    }
+
+private:
+    /** Record that the peer sent the message.
+        @return false if the peer already sent the message
+     */
+    bool
+    addPeerMessage(uint256 const& key, id_t id);
+
+    hash_map<PublicKey, Slot<clock_type>> slots_;
+    // Peers which sent each recently counted message, and when the
+    // message was first counted
+    hash_map<uint256, std::pair<time_point, std::unordered_set<id_t>>>
+        peersWithMessage_;
+    SquelchHandler const& handler_;  // squelch/unsquelch handler
+    beast::Journal const journal_;
+    time_point const startTime_ = clock_type::now();
+    bool reduceRelayReady_ = false;
+};
+
+template <typename clock_type>
+bool
+Slots<clock_type>::addPeerMessage(uint256 const& key, id_t id)
+{
+    auto it = peersWithMessage_.find(key);
+    if (it == peersWithMessage_.end())
+    {
+        peersWithMessage_.emplace(
+            key, std::make_pair(clock_type::now(), std::unordered_set{id}));
+        return true;
+    }
+    return it->second.second.insert(id).second;
+}
+
+template <typename clock_type>
+void
+Slots<clock_type>::updateSlotAndSquelch(
+    uint256 const& key,
+    PublicKey const& validator,
+    id_t id)
+{
+    if (!addPeerMessage(key, id))
+        return;
+
+    auto it = slots_
+                  .emplace(std::make_pair(
+                      validator,
+                      Slot<clock_type>(handler_, journal_)))
+                  .first;
+    it->second.update(validator, id);
+}
+
+template <typename clock_type>
+void
+Slots<clock_type>::deletePeer(id_t id, bool erase)
+{
+    for (auto& [validator, slot] : slots_)
+        slot.deletePeer(validator, id, erase);
+}
+
+template <typename clock_type>
+void
+Slots<clock_type>::deleteIdlePeers()
+{
+    auto now = clock_type::now();
+
+    // Messages are only counted while they are fresh
+    for (auto it = peersWithMessage_.begin(); it != peersWithMessage_.end();)
+    {
+        if (now - it->second.first > IDLED)
+            it = peersWithMessage_.erase(it);
+        else
+            ++it;
+    }
+
+    for (auto it = slots_.begin(); it != slots_.end();)
+    {
+        it->second.deleteIdlePeer(it->first);
+        if (now - it->second.getLastSelected() > MAX_UNSQUELCH_EXPIRE)
+        {
+            JLOG(journal_.debug())
+                << "deleteIdlePeers: deleting idle slot " << Slice(it->first);
+            it = slots_.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+}  // namespace squelch
+
+}  // namespace ripple
+
+#endif
@@ -202,7 +202,10 @@ ConnectAttempt::onHandshake(error_code ec)
         return close();  // makeSharedValue logs
 
     req_ = makeRequest(
-        !overlay_.peerFinder().config().peerPrivate, app_.config().COMPRESSION);
+        !overlay_.peerFinder().config().peerPrivate,
+        app_.config().COMPRESSION,
+        app_.config().VP_REDUCE_RELAY_ENABLE,
+        app_.config().TX_REDUCE_RELAY_ENABLE);
 
     buildHandshake(
         req_,
@@ -282,7 +285,11 @@ ConnectAttempt::onShutdown(error_code ec)
 //--------------------------------------------------------------------------
 
 auto
-ConnectAttempt::makeRequest(bool crawl, bool compressionEnabled) -> request_type
+ConnectAttempt::makeRequest(
+    bool crawl,
+    bool compressionEnabled,
+    bool vpReduceRelayEnabled,
+    bool txReduceRelayEnabled) -> request_type
 {
     request_type m;
     m.method(boost::beast::http::verb::get);
@@ -295,6 +302,10 @@ ConnectAttempt::makeRequest(bool crawl, bool compressionEnabled) -> request_type
     m.insert("Crawl", crawl ? "public" : "private");
     if (compressionEnabled)
         m.insert("X-Offer-Compression", "lz4");
+    if (auto const features = makeFeaturesRequestHeader(
+            vpReduceRelayEnabled, txReduceRelayEnabled);
+        !features.empty())
+        m.insert("X-Protocol-Ctl", features);
     return m;
 }
 
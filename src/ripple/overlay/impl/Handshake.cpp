@@ -25,15 +25,84 @@
 #include <ripple/beast/rfc2616.h>
 #include <ripple/overlay/impl/Handshake.h>
 #include <ripple/protocol/digest.h>
+#include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 #include <algorithm>
 #include <chrono>
+#include <sstream>
+#include <vector>
 
 // VFALCO Shouldn't we have to include the OpenSSL
 // headers or something for SSL_get_finished?
 
 namespace ripple {
 
+boost::optional<std::string>
+getFeatureValue(
+    boost::beast::http::fields const& headers,
+    std::string const& feature)
+{
+    auto const header = headers.find("X-Protocol-Ctl");
+    if (header == headers.end())
+        return boost::none;
+
+    std::vector<std::string> features;
+    boost::split(
+        features, header->value().to_string(), boost::is_any_of(DELIM_FEATURE));
+
+    for (auto& f : features)
+    {
+        auto const pos = f.find('=');
+        if (pos == std::string::npos)
+            continue;
+
+        auto name = f.substr(0, pos);
+        boost::trim(name);
+        if (!boost::iequals(name, feature))
+            continue;
+
+        auto value = f.substr(pos + 1);
+        boost::trim(value);
+        return value;
+    }
+
+    return boost::none;
+}
+
+bool
+featureEnabled(
+    boost::beast::http::fields const& headers,
+    std::string const& feature)
+{
+    auto const value = getFeatureValue(headers, feature);
+    return value && *value == "1";
+}
+
+std::string
+makeFeaturesRequestHeader(bool vpReduceRelayEnabled, bool txReduceRelayEnabled)
+{
+    std::stringstream str;
+    if (vpReduceRelayEnabled)
+        str << FEATURE_VPRR << "=1" << DELIM_FEATURE;
+    if (txReduceRelayEnabled)
+        str << FEATURE_TXRR << "=1" << DELIM_FEATURE;
+    return str.str();
+}
+
+std::string
+makeFeaturesResponseHeader(
+    boost::beast::http::fields const& headers,
+    bool vpReduceRelayEnabled,
+    bool txReduceRelayEnabled)
+{
+    std::stringstream str;
+    if (peerFeatureEnabled(headers, FEATURE_VPRR, vpReduceRelayEnabled))
+        str << FEATURE_VPRR << "=1" << DELIM_FEATURE;
+    if (peerFeatureEnabled(headers, FEATURE_TXRR, txReduceRelayEnabled))
+        str << FEATURE_TXRR << "=1" << DELIM_FEATURE;
+    return str.str();
+}
+
 /** Hashes the latest finished message from an SSL stream.
 
     @param ssl the session to get the message from.
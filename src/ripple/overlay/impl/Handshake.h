@@ -32,6 +32,7 @@
 #include <boost/asio/ssl.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/optional.hpp>
+#include <string>
 #include <utility>
 
 namespace ripple {
@@ -39,6 +40,80 @@ namespace ripple {
 using socket_type = boost::beast::tcp_stream;
 using stream_type = boost::beast::ssl_stream<socket_type>;
 
+/** Optional protocol features are negotiated with the "X-Protocol-Ctl"
+    header. Its value is a list of feature=value pairs separated by ';'.
+    The initiating peer offers the features it has enabled in the request
+    and the accepting peer echoes back those it has enabled as well.
+*/
+static constexpr char FEATURE_VPRR[] =
+    "vprr";  // validation/proposal reduce-relay
+static constexpr char FEATURE_TXRR[] = "txrr";  // transaction reduce-relay
+static constexpr char DELIM_FEATURE[] = ";";
+
+/** Get the value of a feature from the X-Protocol-Ctl header.
+
+    @param headers request or response headers
+    @param feature the name of the feature
+    @return the value of the feature if present; an unseated optional
+            otherwise.
+*/
+boost::optional<std::string>
+getFeatureValue(
+    boost::beast::http::fields const& headers,
+    std::string const& feature);
+
+/** Check if a feature is enabled, which is the case if its value is "1".
+
+    @param headers request or response headers
+    @param feature the name of the feature
+*/
+bool
+featureEnabled(
+    boost::beast::http::fields const& headers,
+    std::string const& feature);
+
+/** Check if a feature should be enabled on a link to a peer. It is only
+    enabled if we have it enabled and the peer advertised it.
+
+    @param headers request (inbound link) or response (outbound link) headers
+    @param feature the name of the feature
+    @param config true if the feature is enabled in our configuration
+*/
+inline bool
+peerFeatureEnabled(
+    boost::beast::http::fields const& headers,
+    std::string const& feature,
+    bool config)
+{
+    return config && featureEnabled(headers, feature);
+}
+
+/** Make the X-Protocol-Ctl value for an outbound handshake request.
+
+    @param vpReduceRelayEnabled true if validation/proposal reduce-relay
+           is enabled
+    @param txReduceRelayEnabled true if transaction reduce-relay is enabled
+    @return the header value; empty if no features are enabled.
+*/
+std::string
+makeFeaturesRequestHeader(bool vpReduceRelayEnabled, bool txReduceRelayEnabled);
+
+/** Make the X-Protocol-Ctl value for a handshake response. A feature is
+    included only if the peer offered it in the request and it is enabled
+    locally.
+
+    @param headers the peer's request headers
+    @param vpReduceRelayEnabled true if validation/proposal reduce-relay
+           is enabled
+    @param txReduceRelayEnabled true if transaction reduce-relay is enabled
+    @return the header value; empty if no features are enabled.
+*/
+std::string
+makeFeaturesResponseHeader(
+    boost::beast::http::fields const& headers,
+    bool vpReduceRelayEnabled,
+    bool txReduceRelayEnabled);
+
 /** Computes a shared value based on the SSL connection state.
 
     When there is no man in the middle, both sides will compute the same
@@ -23,8 +23,12 @@
 
 namespace ripple {
 
-Message::Message(::google::protobuf::Message const& message, int type)
+Message::Message(
+    ::google::protobuf::Message const& message,
+    int type,
+    boost::optional<PublicKey> const& validator)
     : category_(TrafficCount::categorize(message, type, false))
+    , validatorKey_(validator)
 {
     using namespace ripple::compression;
 
@@ -64,6 +68,7 @@ Message::compress()
             case protocol::mtLEDGER_DATA:
             case protocol::mtGET_OBJECTS:
             case protocol::mtVALIDATORLIST:
+            case protocol::mtTRANSACTIONS:
                 return true;
             case protocol::mtPING:
             case protocol::mtCLUSTER:
@@ -75,6 +80,8 @@ Message::compress()
             case protocol::mtSHARD_INFO:
             case protocol::mtGET_PEER_SHARD_INFO:
             case protocol::mtPEER_SHARD_INFO:
+            case protocol::mtHAVE_TRANSACTIONS:
+            case protocol::mtSQUELCH:
                 break;
         }
         return false;
@@ -24,6 +24,7 @@
 #include <ripple/app/misc/ValidatorSite.h>
 #include <ripple/basics/base64.h>
 #include <ripple/basics/make_SSLContext.h>
+#include <ripple/basics/random.h>
 #include <ripple/beast/core/LexicalCast.h>
 #include <ripple/core/DatabaseCon.h>
 #include <ripple/nodestore/DatabaseShard.h>
@@ -39,6 +40,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/utility/in_place_factory.hpp>
 
+#include <algorithm>
+
 namespace ripple {
 
 namespace CrawlOptions {
@@ -99,6 +102,8 @@ OverlayImpl::Timer::on_timer(error_code ec)
     overlay_.m_peerFinder->once_per_second();
     overlay_.sendEndpoints();
     overlay_.autoConnect();
+    overlay_.sendTxQueue();
+    overlay_.deleteIdlePeers();
 
     if ((++overlay_.timer_count_ % Tuning::checkSeconds) == 0)
         overlay_.check();
@@ -139,6 +144,7 @@ OverlayImpl::OverlayImpl(
     , m_resolver(resolver)
     , next_id_(1)
     , timer_count_(0)
+    , slots_(*this, app.journal("Slots"))
     , m_stats(
           std::bind(&OverlayImpl::collect_metrics, this),
           collector,
@@ -670,8 +676,13 @@ OverlayImpl::activate(std::shared_ptr<PeerImp> const& peer)
 void
 OverlayImpl::onPeerDeactivate(Peer::id_t id)
 {
-    std::lock_guard lock(mutex_);
-    ids_.erase(id);
+    {
+        std::lock_guard lock(mutex_);
+        ids_.erase(id);
+    }
+
+    if (app_.config().VP_REDUCE_RELAY_ENABLE)
+        post(strand_, [this, id]() { slots_.deletePeer(id, true); });
 }
 
 void
@@ -1212,7 +1223,7 @@ OverlayImpl::check()
 }
 
 std::shared_ptr<Peer>
-OverlayImpl::findPeerByShortID(Peer::id_t const& id)
+OverlayImpl::findPeerByShortID(Peer::id_t const& id) const
 {
     std::lock_guard lock(mutex_);
     auto const iter = ids_.find(id);
@@ -1245,18 +1256,23 @@ OverlayImpl::broadcast(protocol::TMProposeSet& m)
     for_each([&](std::shared_ptr<PeerImp>&& p) { p->send(sm); });
 }
 
-void
-OverlayImpl::relay(protocol::TMProposeSet& m, uint256 const& uid)
+std::set<Peer::id_t>
+OverlayImpl::relay(
+    protocol::TMProposeSet& m,
+    uint256 const& uid,
+    PublicKey const& validator)
 {
     if (auto const toSkip = app_.getHashRouter().shouldRelay(uid))
     {
-        auto const sm =
-            std::make_shared<Message>(m, protocol::mtPROPOSE_LEDGER);
+        auto const sm = std::make_shared<Message>(
+            m, protocol::mtPROPOSE_LEDGER, validator);
         for_each([&](std::shared_ptr<PeerImp>&& p) {
             if (toSkip->find(p->id()) == toSkip->end())
                 p->send(sm);
         });
+        return *toSkip;
     }
+    return {};
 }
 
 void
@@ -1266,16 +1282,79 @@ OverlayImpl::broadcast(protocol::TMValidation& m)
     for_each([sm](std::shared_ptr<PeerImp>&& p) { p->send(sm); });
 }
 
-void
-OverlayImpl::relay(protocol::TMValidation& m, uint256 const& uid)
+std::set<Peer::id_t>
+OverlayImpl::relay(
+    protocol::TMValidation& m,
+    uint256 const& uid,
+    PublicKey const& validator)
 {
     if (auto const toSkip = app_.getHashRouter().shouldRelay(uid))
     {
-        auto const sm = std::make_shared<Message>(m, protocol::mtVALIDATION);
+        auto const sm =
+            std::make_shared<Message>(m, protocol::mtVALIDATION, validator);
         for_each([&](std::shared_ptr<PeerImp>&& p) {
             if (toSkip->find(p->id()) == toSkip->end())
                 p->send(sm);
         });
+        return *toSkip;
+    }
+    return {};
+}
+
+void
+OverlayImpl::relay(
+    uint256 const& hash,
+    protocol::TMTransaction& m,
+    std::set<Peer::id_t> const& toSkip)
+{
+    auto const sm = std::make_shared<Message>(m, protocol::mtTRANSACTION);
+
+    if (!app_.config().TX_REDUCE_RELAY_ENABLE)
+    {
+        for_each([&](std::shared_ptr<PeerImp>&& p) {
+            if (toSkip.find(p->id()) == toSkip.end())
+                p->send(sm);
+        });
+        return;
+    }
+
+    // Peers which don't support reduce-relay always get the full
+    // transaction. The remaining full relays go to a random subset of
+    // the peers which do; the rest only get the hash announced.
+    std::vector<std::shared_ptr<PeerImp>> reduceRelayPeers;
+    std::size_t total = 0;
+    std::size_t relayed = 0;
+    for_each([&](std::shared_ptr<PeerImp>&& p) {
+        ++total;
+        if (toSkip.find(p->id()) != toSkip.end())
+            return;
+        if (p->supportsFeature(ProtocolFeature::TxReduceRelay))
+        {
+            reduceRelayPeers.emplace_back(std::move(p));
+            return;
+        }
+        p->send(sm);
+        ++relayed;
+    });
+
+    auto const target = std::max<std::size_t>(
+        app_.config().TX_REDUCE_RELAY_MIN_PEERS,
+        total * app_.config().TX_RELAY_PERCENTAGE / 100);
+
+    std::shuffle(
+        reduceRelayPeers.begin(), reduceRelayPeers.end(), default_prng());
+
+    for (auto& p : reduceRelayPeers)
+    {
+        if (relayed < target)
+        {
+            p->send(sm);
+            ++relayed;
+        }
+        else
+        {
+            p->addTxQueue(hash);
+        }
     }
 }
 
@@ -1348,6 +1427,98 @@ OverlayImpl::sendEndpoints()
     }
 }
 
+void
+OverlayImpl::sendTxQueue()
+{
+    if (!app_.config().TX_REDUCE_RELAY_ENABLE)
+        return;
+
+    for_each([](std::shared_ptr<PeerImp>&& p) { p->sendTxQueue(); });
+}
+
+void
+OverlayImpl::updateSlotAndSquelch(
+    uint256 const& key,
+    PublicKey const& validator,
+    Peer::id_t peer)
+{
+    if (!app_.config().VP_REDUCE_RELAY_ENABLE)
+        return;
+
+    if (!strand_.running_in_this_thread())
+        return post(strand_, [this, key, validator, peer]() {
+            updateSlotAndSquelch(key, validator, peer);
+        });
+
+    if (!slots_.reduceRelayReady())
+        return;
+
+    slots_.updateSlotAndSquelch(key, validator, peer);
+}
+
+void
+OverlayImpl::updateSlotAndSquelch(
+    uint256 const& key,
+    PublicKey const& validator,
+    std::set<Peer::id_t>&& peers)
+{
+    if (!app_.config().VP_REDUCE_RELAY_ENABLE)
+        return;
+
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_,
+            [this, key, validator, peers = std::move(peers)]() mutable {
+                updateSlotAndSquelch(key, validator, std::move(peers));
+            });
+
+    if (!slots_.reduceRelayReady())
+        return;
+
+    for (auto const id : peers)
+        slots_.updateSlotAndSquelch(key, validator, id);
+}
+
+void
+OverlayImpl::deleteIdlePeers()
+{
+    if (!app_.config().VP_REDUCE_RELAY_ENABLE)
+        return;
+
+    assert(strand_.running_in_this_thread());
+    slots_.deleteIdlePeers();
+}
+
+void
+OverlayImpl::squelch(
+    PublicKey const& validator,
+    Peer::id_t id,
+    std::uint32_t squelchDuration) const
+{
+    if (auto peer = findPeerByShortID(id);
+        peer && peer->supportsFeature(ProtocolFeature::VpReduceRelay))
+    {
+        protocol::TMSquelch m;
+        m.set_squelch(true);
+        m.set_validatorpubkey(validator.data(), validator.size());
+        m.set_squelchduration(squelchDuration);
+        peer->send(std::make_shared<Message>(m, protocol::mtSQUELCH));
+    }
+}
+
+void
+OverlayImpl::unsquelch(PublicKey const& validator, Peer::id_t id) const
+{
+    if (auto peer = findPeerByShortID(id);
+        peer && peer->supportsFeature(ProtocolFeature::VpReduceRelay))
+    {
+        protocol::TMSquelch m;
+        m.set_squelch(false);
+        m.set_validatorpubkey(validator.data(), validator.size());
+        peer->send(std::make_shared<Message>(m, protocol::mtSQUELCH));
+    }
+}
+
 Overlay::Setup
 setup_Overlay(BasicConfig const& config)
 {
@@ -25,7 +25,9 @@
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/basics/chrono.h>
 #include <ripple/core/Job.h>
+#include <ripple/basics/UptimeClock.h>
 #include <ripple/overlay/Overlay.h>
+#include <ripple/overlay/Slot.h>
 #include <ripple/overlay/impl/Handshake.h>
 #include <ripple/overlay/impl/TrafficCount.h>
 #include <ripple/peerfinder/PeerfinderManager.h>
@@ -52,7 +54,7 @@ namespace ripple {
 class PeerImp;
 class BasicConfig;
 
-class OverlayImpl : public Overlay
+class OverlayImpl : public Overlay, public squelch::SquelchHandler
 {
 public:
     class Child
@@ -124,6 +126,10 @@ private:
 
     boost::optional<std::uint32_t> networkID_;
 
+    // Per-validator peer selection for validation/proposal reduce-relay.
+    // Only accessed on the strand.
+    squelch::Slots<UptimeClock> slots_;
+
     //--------------------------------------------------------------------------
 
 public:
@@ -195,7 +201,7 @@ public:
     void checkSanity(std::uint32_t) override;
 
     std::shared_ptr<Peer>
-    findPeerByShortID(Peer::id_t const& id) override;
+    findPeerByShortID(Peer::id_t const& id) const override;
 
     std::shared_ptr<Peer>
     findPeerByPublicKey(PublicKey const& pubKey) override;
@@ -206,11 +212,23 @@ public:
     void
     broadcast(protocol::TMValidation& m) override;
 
-    void
-    relay(protocol::TMProposeSet& m, uint256 const& uid) override;
+    std::set<Peer::id_t>
+    relay(
+        protocol::TMProposeSet& m,
+        uint256 const& uid,
+        PublicKey const& validator) override;
+
+    std::set<Peer::id_t>
+    relay(
+        protocol::TMValidation& m,
+        uint256 const& uid,
+        PublicKey const& validator) override;
 
     void
-    relay(protocol::TMValidation& m, uint256 const& uid) override;
+    relay(
+        uint256 const& hash,
+        protocol::TMTransaction& m,
+        std::set<Peer::id_t> const& toSkip) override;
 
     //--------------------------------------------------------------------------
     //
@@ -364,7 +382,44 @@ public:
     void
     lastLink(std::uint32_t id);
 
+    /** Updates message count for validator/peer. Sends TMSquelch if the
+        number of messages for N peers reaches threshold T. A message is
+        counted if a peer receives the message for the first time and if
+        the message has been relayed.
+
+        @param key Unique message's key
+        @param validator Validator's public key
+        @param peer Peer's id to update the slots for
+     */
+    void
+    updateSlotAndSquelch(
+        uint256 const& key,
+        PublicKey const& validator,
+        Peer::id_t peer);
+
+    /** Updates message count for validator/peers. Called with the peers
+        which sent us the message before it was verified and relayed.
+
+        @param key Unique message's key
+        @param validator Validator's public key
+        @param peers Peers' ids to update the slots for
+     */
+    void
+    updateSlotAndSquelch(
+        uint256 const& key,
+        PublicKey const& validator,
+        std::set<Peer::id_t>&& peers);
+
 private:
+    void
+    squelch(
+        PublicKey const& validator,
+        Peer::id_t id,
+        std::uint32_t squelchDuration) const override;
+
+    void
+    unsquelch(PublicKey const& validator, Peer::id_t id) const override;
+
     std::shared_ptr<Writer>
     makeRedirectResponse(
         std::shared_ptr<PeerFinder::Slot> const& slot,
@@ -481,6 +536,15 @@ private:
     void
     sendEndpoints();
 
+    /** Send the queued transaction hash announcements to every peer. */
+    void
+    sendTxQueue();
+
+    /** Check if peers stopped relaying messages
+        and if slots stopped receiving messages from the validator */
+    void
+    deleteIdlePeers();
+
 private:
     struct TrafficGauges
     {
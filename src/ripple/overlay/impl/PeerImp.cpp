@@ -21,6 +21,8 @@
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/InboundTransactions.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/OpenLedger.h>
+#include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -93,6 +95,15 @@ PeerImp::PeerImp(
     , compressionEnabled_(
           headers_["X-Offer-Compression"] == "lz4" ? Compressed::On
                                                    : Compressed::Off)
+    , vpReduceRelayEnabled_(peerFeatureEnabled(
+          headers_,
+          FEATURE_VPRR,
+          app_.config().VP_REDUCE_RELAY_ENABLE))
+    , squelch_(p_journal_)
+    , txReduceRelayEnabled_(peerFeatureEnabled(
+          headers_,
+          FEATURE_TXRR,
+          app_.config().TX_REDUCE_RELAY_ENABLE))
 {
 }
 
@@ -219,6 +230,17 @@ PeerImp::stop()
 void
 PeerImp::send(std::shared_ptr<Message> const& m)
 {
+    // The peer asked us not to relay this validator's messages
+    if (auto const& validator = m->getValidatorKey();
+        validator && !squelch_.expireSquelch(*validator))
+    {
+        overlay_.reportTraffic(
+            TrafficCount::category::squelch_suppressed,
+            false,
+            static_cast<int>(m->getBuffer(Compressed::Off).size()));
+        return;
+    }
+
     if (!strand_.running_in_this_thread())
         return post(strand_, std::bind(&PeerImp::send, shared_from_this(), m));
     if (gracefulClose_)
@@ -268,6 +290,53 @@ PeerImp::send(std::shared_ptr<Message> const& m)
                 std::placeholders::_2)));
 }
 
+void
+PeerImp::addTxQueue(uint256 const& hash)
+{
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_,
+            std::bind(&PeerImp::addTxQueue, shared_from_this(), hash));
+
+    if (txQueue_.size() == Tuning::maxTxQueueSize)
+    {
+        JLOG(p_journal_.warn()) << "addTxQueue: queue is full";
+        sendTxQueue();
+    }
+
+    txQueue_.insert(hash);
+}
+
+void
+PeerImp::sendTxQueue()
+{
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_, std::bind(&PeerImp::sendTxQueue, shared_from_this()));
+
+    if (txQueue_.empty())
+        return;
+
+    protocol::TMHaveTransactions ht;
+    for (auto const& hash : txQueue_)
+        ht.add_hashes(hash.data(), hash.size());
+    txQueue_.clear();
+
+    JLOG(p_journal_.trace()) << "sendTxQueue: " << ht.hashes_size();
+    send(std::make_shared<Message>(ht, protocol::mtHAVE_TRANSACTIONS));
+}
+
+void
+PeerImp::removeTxQueue(uint256 const& hash)
+{
+    if (!strand_.running_in_this_thread())
+        return post(
+            strand_,
+            std::bind(&PeerImp::removeTxQueue, shared_from_this(), hash));
+
+    txQueue_.erase(hash);
+}
+
 void
 PeerImp::charge(Resource::Charge const& fee)
 {
@@ -428,6 +497,10 @@ PeerImp::supportsFeature(ProtocolFeature f) const
     {
         case ProtocolFeature::ValidatorListPropagation:
             return protocol_ >= make_protocol(2, 1);
+        case ProtocolFeature::TxReduceRelay:
+            return txReduceRelayEnabled_;
+        case ProtocolFeature::VpReduceRelay:
+            return vpReduceRelayEnabled_;
     }
     return false;
 }
@@ -775,6 +848,12 @@ PeerImp::makeResponse(
     resp.insert("Crawl", crawl ? "public" : "private");
     if (req["X-Offer-Compression"] == "lz4" && app_.config().COMPRESSION)
         resp.insert("X-Offer-Compression", "lz4");
+    if (auto const features = makeFeaturesResponseHeader(
+            req,
+            app_.config().VP_REDUCE_RELAY_ENABLE,
+            app_.config().TX_REDUCE_RELAY_ENABLE);
+        !features.empty())
+        resp.insert("X-Protocol-Ctl", features);
 
     buildHandshake(
         resp,
@@ -1452,6 +1531,14 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMEndpoints> const& m)
 
 void
 PeerImp::onMessage(std::shared_ptr<protocol::TMTransaction> const& m)
+{
+    handleTransaction(m, true);
+}
+
+void
+PeerImp::handleTransaction(
+    std::shared_ptr<protocol::TMTransaction> const& m,
+    bool eraseTxQueue)
 {
     if (sanity_.load() == Sanity::insane)
         return;
@@ -1472,6 +1559,10 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMTransaction> const& m)
         auto stx = std::make_shared<STTx const>(sit);
         uint256 txID = stx->getTransactionID();
 
+        // The peer has this transaction, there is no point announcing it
+        if (eraseTxQueue && txReduceRelayEnabled_)
+            removeTxQueue(txID);
+
         if (stx->isFieldPresent(sfEmitDetails))
         {
             JLOG(p_journal_.warn()) << "Ignoring Network relayed Tx containing sfEmitDetails.";
@@ -1653,14 +1744,23 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMProposeSet> const& m)
         publicKey.slice(),
         sig);
 
-    if (!app_.getHashRouter().addSuppressionPeer(suppression, id_))
-    {
+    auto const isTrusted = app_.validators().trusted(publicKey);
+
+    if (auto const [added, relayed] =
+            app_.getHashRouter().addSuppressionPeerWithStatus(suppression, id_);
+        !added)
+    {
+        // Count a trusted proposal this peer sends us after we relayed it,
+        // so that the peers relaying it redundantly can be squelched. A
+        // proposal we haven't relayed may be forged, so it is counted in
+        // checkPropose once it has been verified.
+        if (isTrusted && vpReduceRelayEnabled_ && relayed &&
+            (stopwatch().now() - *relayed) < squelch::IDLED)
+            overlay_.updateSlotAndSquelch(suppression, publicKey, id_);
         JLOG(p_journal_.trace()) << "Proposal: duplicate";
         return;
     }
 
-    auto const isTrusted = app_.validators().trusted(publicKey);
-
     if (!isTrusted)
     {
         if (sanity_.load() == Sanity::insane)
@@ -2152,16 +2252,26 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMValidation> const& m)
             return;
         }
 
-        if (!app_.getHashRouter().addSuppressionPeer(
-                sha512Half(makeSlice(m->validation())), id_))
-        {
+        auto const isTrusted =
+            app_.validators().trusted(val->getSignerPublic());
+
+        auto const key = sha512Half(makeSlice(m->validation()));
+        if (auto const [added, relayed] =
+                app_.getHashRouter().addSuppressionPeerWithStatus(key, id_);
+            !added)
+        {
+            // Count a trusted validation this peer sends us after we
+            // relayed it, so that redundant relaying peers can be
+            // squelched. Validations we haven't relayed yet are counted
+            // in checkValidation once they have been verified.
+            if (isTrusted && vpReduceRelayEnabled_ && relayed &&
+                (stopwatch().now() - *relayed) < squelch::IDLED)
+                overlay_.updateSlotAndSquelch(
+                    key, val->getSignerPublic(), id_);
             JLOG(p_journal_.trace()) << "Validation: duplicate";
             return;
         }
 
-        auto const isTrusted =
-            app_.validators().trusted(val->getSignerPublic());
-
         if (!isTrusted && (sanity_.load() == Sanity::insane))
         {
             JLOG(p_journal_.debug())
@@ -2211,6 +2321,20 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
             return;
         }
 
+        if (packet.type() == protocol::TMGetObjectByHash::otTRANSACTIONS)
+        {
+            if (!txReduceRelayEnabled_)
+            {
+                JLOG(p_journal_.debug())
+                    << "GetObject: tx reduce-relay is not enabled";
+                fee_ = Resource::feeUnwantedData;
+                return;
+            }
+
+            doTransactions(m);
+            return;
+        }
+
         fee_ = Resource::feeMediumBurdenPeer;
 
         protocol::TMGetObjectByHash reply;
@@ -2276,6 +2400,29 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
     else
     {
         // this is a reply
+        if (packet.type() == protocol::TMGetObjectByHash::otFETCH_PACK &&
+            packet.delta())
+        {
+            if (!stringIsUint256Sized(packet.ledgerhash()) ||
+                !app_.getLedgerMaster().takeFetchPackDelta(
+                    uint256{packet.ledgerhash()}, id_))
+            {
+                JLOG(p_journal_.debug()) << "GetObj: Unrequested delta";
+                fee_ = Resource::feeUnwantedData;
+                return;
+            }
+
+            // Rebuilding the state nodes takes a while
+            std::weak_ptr<PeerImp> weak = shared_from_this();
+            app_.getJobQueue().addJob(
+                jtLEDGER_DATA,
+                "gotFetchPackDelta",
+                [&app = app_, weak, m](Job&) {
+                    app.getLedgerMaster().addFetchPackDelta(weak, m);
+                });
+            return;
+        }
+
         std::uint32_t pLSeq = 0;
         bool pLDo = true;
         bool progress = false;
@@ -2330,6 +2477,158 @@ PeerImp::onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m)
     }
 }
 
+void
+PeerImp::onMessage(std::shared_ptr<protocol::TMHaveTransactions> const& m)
+{
+    if (!txReduceRelayEnabled_)
+    {
+        JLOG(p_journal_.debug())
+            << "HaveTransactions: tx reduce-relay is not enabled";
+        fee_ = Resource::feeUnwantedData;
+        return;
+    }
+
+    if (m->hashes_size() > Tuning::maxTxQueueSize)
+    {
+        JLOG(p_journal_.warn()) << "HaveTransactions: too many hashes";
+        fee_ = Resource::feeInvalidRequest;
+        return;
+    }
+
+    if (sanity_.load() == Sanity::insane ||
+        app_.getOPs().isNeedNetworkLedger())
+        return;
+
+    for (auto const& hash : m->hashes())
+    {
+        if (!stringIsUint256Sized(hash))
+        {
+            JLOG(p_journal_.warn()) << "HaveTransactions: invalid hash size";
+            fee_ = Resource::feeInvalidRequest;
+            return;
+        }
+    }
+
+    std::weak_ptr<PeerImp> weak = shared_from_this();
+    app_.getJobQueue().addJob(
+        jtTRANSACTION, "recvHaveTransactions", [weak, m](Job&) {
+            auto peer = weak.lock();
+            if (!peer)
+                return;
+
+            protocol::TMGetObjectByHash query;
+            query.set_type(protocol::TMGetObjectByHash::otTRANSACTIONS);
+            query.set_query(true);
+
+            std::vector<uint256> hashes;
+            hashes.reserve(m->hashes_size());
+
+            for (auto const& h : m->hashes())
+            {
+                uint256 const hash{h};
+
+                // The peer has the transaction, so it must not be relayed
+                // or announced back to it.
+                auto& router = peer->app_.getHashRouter();
+                router.addSuppressionPeer(hash, peer->id_);
+
+                // Ask for the transaction unless we have it or recently
+                // asked another peer. If that peer never answers, the
+                // next announcement after the timeout asks again.
+                if (!peer->app_.getMasterTransaction().fetch_from_cache(
+                        hash) &&
+                    router.shouldRequest(hash, Tuning::txRequestTimeout))
+                    query.add_objects()->set_hash(hash.data(), hash.size());
+
+                hashes.push_back(hash);
+            }
+
+            post(peer->strand_, [peer, hashes = std::move(hashes)]() {
+                for (auto const& hash : hashes)
+                    peer->txQueue_.erase(hash);
+            });
+
+            if (query.objects_size() > 0)
+            {
+                JLOG(peer->p_journal_.trace())
+                    << "HaveTransactions: requesting " << query.objects_size()
+                    << " of " << m->hashes_size();
+                peer->send(std::make_shared<Message>(
+                    query, protocol::mtGET_OBJECTS));
+            }
+        });
+}
+
+void
+PeerImp::onMessage(std::shared_ptr<protocol::TMTransactions> const& m)
+{
+    if (!txReduceRelayEnabled_)
+    {
+        JLOG(p_journal_.debug())
+            << "Transactions: tx reduce-relay is not enabled";
+        fee_ = Resource::feeUnwantedData;
+        return;
+    }
+
+    if (m->transactions_size() > Tuning::maxTxQueueSize)
+    {
+        JLOG(p_journal_.warn()) << "Transactions: too many transactions";
+        fee_ = Resource::feeInvalidRequest;
+        return;
+    }
+
+    for (auto const& tx : m->transactions())
+        handleTransaction(
+            std::make_shared<protocol::TMTransaction>(tx), false);
+}
+
+void
+PeerImp::onMessage(std::shared_ptr<protocol::TMSquelch> const& m)
+{
+    if (!vpReduceRelayEnabled_)
+    {
+        JLOG(p_journal_.debug()) << "Squelch: vp reduce-relay is not enabled";
+        fee_ = Resource::feeUnwantedData;
+        return;
+    }
+
+    if (!m->has_validatorpubkey())
+    {
+        fee_ = Resource::feeBadData;
+        return;
+    }
+
+    auto const validator = m->validatorpubkey();
+    auto const slice{makeSlice(validator)};
+    if (!publicKeyType(slice))
+    {
+        JLOG(p_journal_.debug()) << "Squelch: malformed validator key";
+        fee_ = Resource::feeBadData;
+        return;
+    }
+
+    PublicKey key(slice);
+
+    // Ignore the squelch for our own validator's messages: we are the
+    // only source of them.
+    if (key == app_.getValidationPublicKey())
+    {
+        JLOG(p_journal_.debug()) << "Squelch: received for own validator key";
+        return;
+    }
+
+    if (!m->squelch())
+        squelch_.removeSquelch(key);
+    else if (!squelch_.addSquelch(
+                 key, std::chrono::seconds{m->squelchduration()}))
+        fee_ = Resource::feeBadData;
+
+    JLOG(p_journal_.debug())
+        << "Squelch: " << (m->squelch() ? "squelch " : "unsquelch ")
+        << toBase58(TokenType::NodePublic, key)
+        << " duration " << m->squelchduration();
+}
+
 //--------------------------------------------------------------------------
 
 void
@@ -2382,6 +2681,65 @@ PeerImp::doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet)
         });
 }
 
+void
+PeerImp::doTransactions(
+    std::shared_ptr<protocol::TMGetObjectByHash> const& packet)
+{
+    if (packet->objects_size() > Tuning::maxTxQueueSize)
+    {
+        JLOG(p_journal_.warn())
+            << "GetObject: too many transactions requested";
+        fee_ = Resource::feeInvalidRequest;
+        return;
+    }
+
+    fee_ = Resource::feeMediumBurdenPeer;
+
+    protocol::TMTransactions reply;
+
+    for (auto const& obj : packet->objects())
+    {
+        if (!obj.has_hash() || !stringIsUint256Sized(obj.hash()))
+        {
+            fee_ = Resource::feeInvalidRequest;
+            return;
+        }
+
+        uint256 const hash{obj.hash()};
+
+        // We announced the transaction, so it should still be cached. If
+        // it was recovered into the open ledger it may only be there.
+        std::shared_ptr<STTx const> stx;
+        if (auto const txn = app_.getMasterTransaction().fetch_from_cache(hash))
+            stx = txn->getSTransaction();
+        else
+            stx = app_.openLedger().current()->txRead(hash).first;
+
+        if (!stx)
+        {
+            JLOG(p_journal_.debug())
+                << "GetObject: requested transaction not found " << hash;
+            continue;
+        }
+
+        Serializer s;
+        stx->add(s);
+
+        auto& tx = *reply.add_transactions();
+        tx.set_rawtransaction(s.data(), s.size());
+        tx.set_status(protocol::tsNEW);
+        tx.set_receivetimestamp(
+            app_.timeKeeper().now().time_since_epoch().count());
+    }
+
+    JLOG(p_journal_.trace()) << "GetObject: " << reply.transactions_size()
+                             << " of " << packet->objects_size()
+                             << " transactions";
+
+    if (reply.transactions_size() > 0)
+        send(std::make_shared<Message>(reply, protocol::mtTRANSACTIONS));
+}
+
 void
 PeerImp::checkTransaction(
     int flags,
@@ -2484,7 +2842,18 @@ PeerImp::checkPropose(
         relay = app_.config().RELAY_UNTRUSTED_PROPOSALS || cluster();
 
     if (relay)
-        app_.overlay().relay(*packet, peerPos.suppressionID());
+    {
+        // The peers which sent us the proposal before it was relayed,
+        // including this one, have now been verified and are counted.
+        // Later duplicates are counted as they arrive.
+        auto haveMessage = app_.overlay().relay(
+            *packet, peerPos.suppressionID(), peerPos.publicKey());
+        if (isTrusted && vpReduceRelayEnabled_ && !haveMessage.empty())
+            overlay_.updateSlotAndSquelch(
+                peerPos.suppressionID(),
+                peerPos.publicKey(),
+                std::move(haveMessage));
+    }
 }
 
 void
@@ -2507,7 +2876,16 @@ PeerImp::checkValidation(
         {
             auto const suppression =
                 sha512Half(makeSlice(val->getSerialized()));
-            overlay_.relay(*packet, suppression);
+            // Count the peers which sent us the validation before it was
+            // relayed, as for proposals.
+            auto haveMessage =
+                overlay_.relay(*packet, suppression, val->getSignerPublic());
+            if (app_.validators().trusted(val->getSignerPublic()) &&
+                vpReduceRelayEnabled_ && !haveMessage.empty())
+                overlay_.updateSlotAndSquelch(
+                    suppression,
+                    val->getSignerPublic(),
+                    std::move(haveMessage));
         }
     }
     catch (std::exception const&)
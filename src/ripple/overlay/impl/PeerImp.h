@@ -23,7 +23,9 @@
 #include <ripple/app/consensus/RCLCxPeerPos.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/RangeSet.h>
+#include <ripple/basics/UptimeClock.h>
 #include <ripple/beast/utility/WrappedSink.h>
+#include <ripple/overlay/Squelch.h>
 #include <ripple/overlay/impl/OverlayImpl.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/ProtocolVersion.h>
@@ -196,6 +198,19 @@ private:
 
     Compressed compressionEnabled_ = Compressed::Off;
 
+    // True if validation/proposal reduce-relay was negotiated with this peer
+    bool vpReduceRelayEnabled_ = false;
+
+    // Validators whose messages this peer asked us not to relay to it
+    squelch::Squelch<UptimeClock> squelch_;
+
+    // True if transaction reduce-relay was negotiated with this peer
+    bool txReduceRelayEnabled_ = false;
+
+    // Hashes of the transactions to announce to this peer instead of
+    // relaying them in full. Only accessed on the strand.
+    hash_set<uint256> txQueue_;
+
     friend class OverlayImpl;
 
     class Metrics
@@ -434,6 +449,19 @@ public:
         return compressionEnabled_ == Compressed::On;
     }
 
+    /** Queue a transaction hash to be announced to this peer. */
+    void
+    addTxQueue(uint256 const& hash);
+
+    /** Announce all the queued transaction hashes to this peer. */
+    void
+    sendTxQueue();
+
+    /** Remove a transaction hash from the announcement queue, because the
+        peer already has the transaction. */
+    void
+    removeTxQueue(uint256 const& hash);
+
 private:
     void
     close();
@@ -549,6 +577,12 @@ public:
     onMessage(std::shared_ptr<protocol::TMValidation> const& m);
     void
     onMessage(std::shared_ptr<protocol::TMGetObjectByHash> const& m);
+    void
+    onMessage(std::shared_ptr<protocol::TMHaveTransactions> const& m);
+    void
+    onMessage(std::shared_ptr<protocol::TMTransactions> const& m);
+    void
+    onMessage(std::shared_ptr<protocol::TMSquelch> const& m);
 
 private:
     State
@@ -574,6 +608,18 @@ private:
     void
     doFetchPack(const std::shared_ptr<protocol::TMGetObjectByHash>& packet);
 
+    // Reply to a query for transactions announced with TMHaveTransactions
+    void
+    doTransactions(std::shared_ptr<protocol::TMGetObjectByHash> const& packet);
+
+    // Process a transaction relayed in full or sent in reply to a query.
+    // If eraseTxQueue is true, the transaction is removed from this peer's
+    // announcement queue since the peer evidently has it.
+    void
+    handleTransaction(
+        std::shared_ptr<protocol::TMTransaction> const& m,
+        bool eraseTxQueue);
+
     void
     checkTransaction(
         int flags,
@@ -646,6 +692,15 @@ PeerImp::PeerImp(
           headers_["X-Offer-Compression"] == "lz4" && app_.config().COMPRESSION
               ? Compressed::On
               : Compressed::Off)
+    , vpReduceRelayEnabled_(peerFeatureEnabled(
+          headers_,
+          FEATURE_VPRR,
+          app_.config().VP_REDUCE_RELAY_ENABLE))
+    , squelch_(p_journal_)
+    , txReduceRelayEnabled_(peerFeatureEnabled(
+          headers_,
+          FEATURE_TXRR,
+          app_.config().TX_REDUCE_RELAY_ENABLE))
 {
     read_buffer_.commit(boost::asio::buffer_copy(
         read_buffer_.prepare(boost::asio::buffer_size(buffers)), buffers));
@@ -48,6 +48,15 @@ TrafficCount::categorize(
     if (type == protocol::mtTRANSACTION)
         return TrafficCount::category::transaction;
 
+    if (type == protocol::mtHAVE_TRANSACTIONS)
+        return TrafficCount::category::have_transactions;
+
+    if (type == protocol::mtTRANSACTIONS)
+        return TrafficCount::category::requested_transactions;
+
+    if (type == protocol::mtSQUELCH)
+        return TrafficCount::category::squelch;
+
     if (type == protocol::mtVALIDATORLIST)
         return TrafficCount::category::validatorlist;
 
@@ -107,6 +116,9 @@ TrafficCount::categorize(
 
     if (auto msg = dynamic_cast<protocol::TMGetObjectByHash const*>(&message))
     {
+        if (msg->type() == protocol::TMGetObjectByHash::otTRANSACTIONS)
+            return TrafficCount::category::requested_transactions;
+
         if (msg->type() == protocol::TMGetObjectByHash::otLEDGER)
             return (msg->query() == inbound)
                 ? TrafficCount::category::share_hash_ledger
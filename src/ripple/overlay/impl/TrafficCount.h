@@ -76,6 +76,16 @@ public:
         validatorlist,
         shards,  // shard-related traffic
 
+        // TMHaveTransactions: transaction hashes announced by reduce-relay
+        have_transactions,
+
+        // TMTransactions and TMGetObjectByHash otTRANSACTIONS: transactions
+        // requested after an announcement
+        requested_transactions,
+
+        squelch,             // TMSquelch messages
+        squelch_suppressed,  // messages not relayed because of a squelch
+
         // TMHaveSet message:
         get_set,    // transaction sets we try to get
         share_set,  // transaction sets we get
@@ -192,6 +202,10 @@ protected:
         {"validations"},        // category::validation
         {"validator_lists"},    // category::validatorlist
         {"shards"},             // category::shards
+        {"have_transactions"},  // category::have_transactions
+        {"requested_transactions"},  // category::requested_transactions
+        {"squelch"},                 // category::squelch
+        {"squelch_suppressed"},      // category::squelch_suppressed
         {"set_get"},            // category::get_set
         {"set_share"},          // category::share_set
         {"ledger_data_Transaction_Set_candidate_get"},  // category::ld_tsc_get
@@ -71,8 +71,17 @@ enum {
 
     /** How often to log send queue size */
     sendQueueLogFreq = 64,
+
+    /** How many transaction hashes we queue for a peer before announcing
+        them without waiting for the next timer tick. This is also the
+        limit on the number of hashes in an announcement we receive. */
+    maxTxQueueSize = 10000,
 };
 
+/** How long to wait for a requested transaction before asking another
+    peer that announced it */
+std::chrono::seconds constexpr txRequestTimeout{2};
+
 /** The threshold above which we treat a peer connection as high latency */
 std::chrono::milliseconds constexpr peerHighLatency{300};
 
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <ripple/basics/Log.h>
+#include <ripple/basics/MathUtilities.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/safe_cast.h>
 #include <ripple/beast/core/LexicalCast.h>
@@ -378,16 +379,15 @@ operator+(STAmount const& v1, STAmount const& v2)
     if (v2.negative())
         vv2 = -vv2;
 
-    while (ov1 < ov2)
+    if (ov1 < ov2)
     {
-        vv1 /= 10;
-        ++ov1;
+        vv1 = dropDigits(vv1, ov2 - ov1);
+        ov1 = ov2;
     }
-
-    while (ov2 < ov1)
+    else if (ov2 < ov1)
     {
-        vv2 /= 10;
-        ++ov2;
+        vv2 = dropDigits(vv2, ov1 - ov2);
+        ov2 = ov1;
     }
 
     // This addition cannot overflow an std::int64_t. It can overflow an
@@ -696,19 +696,21 @@ STAmount::canonicalize()
         return;
     }
 
-    while ((mValue < cMinValue) && (mOffset > cMinOffset))
+    if ((mValue < cMinValue) && (mOffset > cMinOffset))
     {
-        mValue *= 10;
-        --mOffset;
+        auto const scale =
+            std::min(16 - decimalDigits(mValue), mOffset - cMinOffset);
+        mValue *= powerOfTen(scale);
+        mOffset -= scale;
     }
-
-    while (mValue > cMaxValue)
+    else if (mValue > cMaxValue)
     {
-        if (mOffset >= cMaxOffset)
+        auto const scale = decimalDigits(mValue) - 16;
+        if (mOffset + scale > cMaxOffset)
             Throw<std::runtime_error>("value overflow");
 
-        mValue /= 10;
-        ++mOffset;
+        mValue /= powerOfTen(scale);
+        mOffset += scale;
     }
 
     if ((mOffset < cMinOffset) || (mValue < cMinValue))
@@ -1012,6 +1014,15 @@ operator-(STAmount const& value)
 //
 //------------------------------------------------------------------------------
 
+// The products below need 128 bits. Where the compiler has a native
+// 128-bit integer we use it: it is exact, like the multiprecision type,
+// but costs a single multiply and a library divide.
+#ifdef __SIZEOF_INT128__
+using uint128_t = unsigned __int128;
+#else
+using uint128_t = boost::multiprecision::uint128_t;
+#endif
+
 // Calculate (a * b) / c when all three values are 64-bit
 // without loss of precision:
 static std::uint64_t
@@ -1020,9 +1031,7 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * multiplicand;
     ret /= divisor;
 
     if (ret > std::numeric_limits<std::uint64_t>::max())
@@ -1042,9 +1051,7 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
-
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
+    uint128_t ret = uint128_t(multiplier) * multiplicand;
     ret += rounding;
     ret /= divisor;
 
@@ -1059,6 +1066,18 @@ muldiv_round(
     return static_cast<uint64_t>(ret);
 }
 
+// Scale a non-zero native mantissa up into the range of an IOU mantissa
+static void
+normalizeNative(std::uint64_t& value, int& offset)
+{
+    if (value < STAmount::cMinValue)
+    {
+        auto const scale = 16 - decimalDigits(value);
+        value *= powerOfTen(scale);
+        offset -= scale;
+    }
+}
+
 STAmount
 divide(STAmount const& num, STAmount const& den, Issue const& issue)
 {
@@ -1074,23 +1093,10 @@ divide(STAmount const& num, STAmount const& den, Issue const& issue)
     int denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            // Need to bring into range
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        normalizeNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        normalizeNative(denVal, denOffset);
 
     // We divide the two mantissas (each is between 10^15
     // and 10^16). To maintain precision, we multiply the
@@ -1132,22 +1138,10 @@ multiply(STAmount const& v1, STAmount const& v2, Issue const& issue)
     int offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        normalizeNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        normalizeNative(value2, offset2);
 
     // We multiply the two mantissas (each is between 10^15
     // and 10^16), so their product is in the 10^30 to 10^32
@@ -1227,22 +1221,10 @@ mulRound(
     int offset1 = v1.exponent(), offset2 = v2.exponent();
 
     if (v1.native())
-    {
-        while (value1 < STAmount::cMinValue)
-        {
-            value1 *= 10;
-            --offset1;
-        }
-    }
+        normalizeNative(value1, offset1);
 
     if (v2.native())
-    {
-        while (value2 < STAmount::cMinValue)
-        {
-            value2 *= 10;
-            --offset2;
-        }
-    }
+        normalizeNative(value2, offset2);
 
     bool const resultNegative = v1.negative() != v2.negative();
 
@@ -1298,22 +1280,10 @@ divRound(
     int numOffset = num.exponent(), denOffset = den.exponent();
 
     if (num.native())
-    {
-        while (numVal < STAmount::cMinValue)
-        {
-            numVal *= 10;
-            --numOffset;
-        }
-    }
+        normalizeNative(numVal, numOffset);
 
     if (den.native())
-    {
-        while (denVal < STAmount::cMinValue)
-        {
-            denVal *= 10;
-            --denOffset;
-        }
-    }
+        normalizeNative(denVal, denOffset);
 
     bool const resultNegative = (num.negative() != den.negative());
 
@@ -100,40 +100,50 @@ STObject::applyTemplate(const SOTemplate& type) noexcept(false)
     decltype(v_) v;
     v.reserve(type.size());
     for (auto const& e : type)
+        v.emplace_back(detail::nonPresentObject, e.sField());
+
+    // Move each field straight into the position the template gives it,
+    // rather than searching the fields once for every template entry.
+    std::vector<bool> matched(type.size(), false);
+    SField const* leftover = nullptr;
+    for (auto& e : v_)
     {
-        auto const iter =
-            std::find_if(v_.begin(), v_.end(), [&](detail::STVar const& b) {
-                return b.get().getFName() == e.sField();
-            });
-        if (iter != v_.end())
+        auto const& name = e->getFName();
+        auto const index = name.getNum() > 0 ? type.getIndex(name) : -1;
+        if (index >= 0 && !matched[index])
+        {
+            matched[index] = true;
+            v[index] = std::move(e);
+        }
+        else if (!leftover && !name.isDiscardable())
         {
-            if ((e.style() == soeDEFAULT) && iter->get().isDefault())
+            // Anything left over in the object must be discardable
+            leftover = &name;
+        }
+    }
+
+    std::size_t index = 0;
+    for (auto const& e : type)
+    {
+        if (matched[index])
+        {
+            if ((e.style() == soeDEFAULT) && v[index]->isDefault())
             {
                 throwFieldErr(
                     e.sField().fieldName,
                     "may not be explicitly set to default.");
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
         }
-        else
+        else if (e.style() == soeREQUIRED)
         {
-            if (e.style() == soeREQUIRED)
-            {
-                throwFieldErr(e.sField().fieldName, "is required but missing.");
-            }
-            v.emplace_back(detail::nonPresentObject, e.sField());
-        }
-    }
-    for (auto const& e : v_)
-    {
-        // Anything left over in the object must be discardable
-        if (!e->getFName().isDiscardable())
-        {
-            throwFieldErr(
-                e->getFName().getName(), "found in disallowed location.");
+            throwFieldErr(e.sField().fieldName, "is required but missing.");
         }
+        ++index;
     }
+
+    if (leftover)
+        throwFieldErr(leftover->getName(), "found in disallowed location.");
+
     // Swap the template matching data in for the old data,
     // freeing any leftover junk
     v_.swap(v);
@@ -156,6 +166,12 @@ STObject::set(SerialIter& sit, int depth) noexcept(false)
 
     v_.clear();
 
+    // Fields serialized canonically arrive in increasing field code order.
+    // In that case there can be no duplicates and there is no need to sort
+    // the fields to look for them.
+    bool canonicalOrder = true;
+    int lastFieldCode = 0;
+
     // Consume data in the pipe until we run out or reach the end
     while (!sit.empty())
     {
@@ -192,6 +208,10 @@ STObject::set(SerialIter& sit, int depth) noexcept(false)
             Throw<std::runtime_error>(ss.str().c_str());
         }
 
+        if (fn.fieldCode <= lastFieldCode)
+            canonicalOrder = false;
+        lastFieldCode = fn.fieldCode;
+
         // Unflatten the field
         v_.emplace_back(sit, fn, depth + 1);
 
@@ -202,15 +222,18 @@ STObject::set(SerialIter& sit, int depth) noexcept(false)
 
     // We want to ensure that the deserialized object does not contain any
     // duplicate fields. This is a key invariant:
-    auto const sf = getSortedFields(*this, withAllFields);
+    if (!canonicalOrder)
+    {
+        auto const sf = getSortedFields(*this, withAllFields);
 
-    auto const dup = std::adjacent_find(
-        sf.cbegin(), sf.cend(), [](STBase const* lhs, STBase const* rhs) {
-            return lhs->getFName() == rhs->getFName();
-        });
+        auto const dup = std::adjacent_find(
+            sf.cbegin(), sf.cend(), [](STBase const* lhs, STBase const* rhs) {
+                return lhs->getFName() == rhs->getFName();
+            });
 
-    if (dup != sf.cend())
-        Throw<std::runtime_error>("Duplicate field detected");
+        if (dup != sf.cend())
+            Throw<std::runtime_error>("Duplicate field detected");
+    }
 
     return reachedEndOfObject;
 }
@@ -148,7 +148,8 @@ JSS(base_fee);               // out: NetworkOPs
 JSS(base_fee_xrp);           // out: NetworkOPs
 JSS(bids);                   // out: Subscribe
 JSS(binary);                 // in: AccountTX, LedgerEntry,
-                             //     AccountTxOld, Tx LedgerData
+                             //     AccountTxOld, Tx LedgerData,
+                             //     Subscribe
 JSS(books);                  // in: Subscribe, Unsubscribe
 JSS(both);                   // in: Subscribe, Unsubscribe
 JSS(both_sides);             // in: Subscribe, Unsubscribe
@@ -295,7 +296,7 @@ JSS(jq_trans_overflow);           // JobQueue transaction limit overflow.
 JSS(kept);                        // out: SubmitTransaction
 JSS(key);                         // out
 JSS(key_type);                    // in/out: WalletPropose, TransactionSign
-JSS(latency);                     // out: PeerImp
+JSS(latency);                     // out: PeerImp, GetCounts, PerfLog
 JSS(last);                        // out: RPCVersion
 JSS(last_close);                  // out: NetworkOPs
 JSS(last_refresh_time);           // out: ValidatorSite
@@ -448,6 +449,7 @@ JSS(reference_level);       // out: TxQ
 JSS(refresh_interval_min);  // out: ValidatorSites
 JSS(regular_seed);          // in/out: LedgerEntry
 JSS(remote);                // out: Logic.h
+JSS(replay);                // in: LedgerCleaner
 JSS(request);               // RPC
 JSS(requested);             // out: Manifest
 JSS(reservations);          // out: Reservations
@@ -97,7 +97,9 @@ doLedgerData(RPC::JsonContext& context)
     auto e = lpLedger->sles.end();
     for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
     {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
+        // The iterator has already deserialized the entry; reading it again
+        // by key would deserialize it a second time.
+        auto sle = *i;
         if (limit-- <= 0)
         {
             // Stop processing before the current key.
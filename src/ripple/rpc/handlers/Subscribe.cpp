@@ -111,6 +111,12 @@ doSubscribe(RPC::JsonContext& context)
         ispSub = context.infoSub;
     }
 
+    // The format follows the latest request, so a subscription made
+    // without binary goes back to JSON
+    ispSub->setBinary(
+        context.params.isMember(jss::binary) &&
+        context.params[jss::binary].asBool());
+
     if (context.params.isMember(jss::streams))
     {
         if (!context.params[jss::streams].isArray())
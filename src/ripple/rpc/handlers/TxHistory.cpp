@@ -27,7 +27,6 @@
 #include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Role.h>
-#include <boost/format.hpp>
 
 namespace ripple {
 
@@ -52,11 +51,9 @@ doTxHistory(RPC::JsonContext& context)
 
     obj[jss::index] = startIndex;
 
-    std::string sql = boost::str(
-        boost::format(
-            "SELECT LedgerSeq, Status, RawTxn "
-            "FROM Transactions ORDER BY LedgerSeq desc LIMIT %u,20;") %
-        startIndex);
+    static std::string const sql(
+        "SELECT LedgerSeq, Status, RawTxn "
+        "FROM Transactions ORDER BY LedgerSeq desc LIMIT :start,20;");
 
     {
         auto db = context.app.getTxnDB().checkoutDb();
@@ -69,6 +66,7 @@ doTxHistory(RPC::JsonContext& context)
 
         soci::statement st =
             (db->prepare << sql,
+             soci::use(startIndex),
              soci::into(ledgerSeq),
              soci::into(status),
              soci::into(sociRawTxnBlob, rti));
@@ -195,6 +195,20 @@ public:
     void
     visitNodes(std::function<bool(SHAMapAbstractNode&)> const& function) const;
 
+    /**  Visit every node below one branch of the root of this SHAMap
+
+         The root itself is not visited. Distinct branches may be visited
+         concurrently from different threads.
+
+         @param branch the branch of the root to visit, from 0 to 15.
+         @param function called with every node visited.
+         If function returns false, visitBranch exits.
+    */
+    void
+    visitBranch(
+        int branch,
+        std::function<bool(SHAMapAbstractNode&)> const& function) const;
+
     /**  Visit every node in this SHAMap that
          is not present in the specified SHAMap
 
@@ -314,6 +328,10 @@ private:
     std::shared_ptr<SHAMapAbstractNode>
     fetchNodeFromDB(SHAMapHash const& hash) const;
     std::shared_ptr<SHAMapAbstractNode>
+    finishFetch(
+        SHAMapHash const& hash,
+        std::shared_ptr<NodeObject> const& object) const;
+    std::shared_ptr<SHAMapAbstractNode>
     fetchNodeNT(SHAMapHash const& hash) const;
     std::shared_ptr<SHAMapAbstractNode>
     fetchNodeNT(SHAMapHash const& hash, SHAMapSyncFilter* filter) const;
@@ -393,6 +411,12 @@ private:
     std::shared_ptr<SHAMapAbstractNode>
     descendNoStore(std::shared_ptr<SHAMapInnerNode> const&, int branch) const;
 
+    /** Visit every node below an inner node, without storing them */
+    void
+    visitChildren(
+        std::shared_ptr<SHAMapInnerNode> node,
+        std::function<bool(SHAMapAbstractNode&)> const& function) const;
+
     /** If there is only one leaf below this node, get its contents */
     std::shared_ptr<SHAMapItem const> const&
     onlyBelow(SHAMapAbstractNode*) const;
@@ -143,31 +143,41 @@ SHAMap::findKey(uint256 const& id) const
 std::shared_ptr<SHAMapAbstractNode>
 SHAMap::fetchNodeFromDB(SHAMapHash const& hash) const
 {
+    if (!backed_)
+        return {};
+
+    return finishFetch(hash, f_.db().fetch(hash.as_uint256(), ledgerSeq_));
+}
+
+// Make a node from an object read from the database
+std::shared_ptr<SHAMapAbstractNode>
+SHAMap::finishFetch(
+    SHAMapHash const& hash,
+    std::shared_ptr<NodeObject> const& object) const
+{
+    assert(backed_);
     std::shared_ptr<SHAMapAbstractNode> node;
 
-    if (backed_)
+    if (object)
     {
-        if (auto obj = f_.db().fetch(hash.as_uint256(), ledgerSeq_))
+        try
         {
-            try
-            {
-                node = SHAMapAbstractNode::makeFromPrefix(
-                    makeSlice(obj->getData()), hash);
-                if (node)
-                    canonicalize(hash, node);
-            }
-            catch (std::exception const&)
-            {
-                JLOG(journal_.warn()) << "Invalid DB node " << hash;
-                return std::shared_ptr<SHAMapTreeNode>();
-            }
+            node = SHAMapAbstractNode::makeFromPrefix(
+                makeSlice(object->getData()), hash);
+            if (node)
+                canonicalize(hash, node);
         }
-        else if (full_)
+        catch (std::exception const&)
         {
-            f_.missingNode(ledgerSeq_);
-            const_cast<bool&>(full_) = false;
+            JLOG(journal_.warn()) << "Invalid DB node " << hash;
+            return std::shared_ptr<SHAMapTreeNode>();
         }
     }
+    else if (full_)
+    {
+        f_.missingNode(ledgerSeq_);
+        const_cast<bool&>(full_) = false;
+    }
 
     return node;
 }
@@ -50,10 +50,41 @@ SHAMap::visitNodes(
     if (!root_->isInner())
         return;
 
+    visitChildren(std::static_pointer_cast<SHAMapInnerNode>(root_), function);
+}
+
+void
+SHAMap::visitBranch(
+    int branch,
+    std::function<bool(SHAMapAbstractNode&)> const& function) const
+{
+    // Visit every node below one branch of the root
+    assert(branch >= 0 && branch < 16);
+
+    if (!root_ || !root_->isInner())
+        return;
+
+    auto root = std::static_pointer_cast<SHAMapInnerNode>(root_);
+    if (root->isEmptyBranch(branch))
+        return;
+
+    std::shared_ptr<SHAMapAbstractNode> child = descendNoStore(root, branch);
+    if (!function(*child))
+        return;
+
+    if (child->isInner())
+        visitChildren(
+            std::static_pointer_cast<SHAMapInnerNode>(child), function);
+}
+
+void
+SHAMap::visitChildren(
+    std::shared_ptr<SHAMapInnerNode> node,
+    std::function<bool(SHAMapAbstractNode&)> const& function) const
+{
     using StackEntry = std::pair<int, std::shared_ptr<SHAMapInnerNode>>;
     std::stack<StackEntry, std::vector<StackEntry>> stack;
 
-    auto node = std::static_pointer_cast<SHAMapInnerNode>(root_);
     int pos = 0;
 
     while (1)
@@ -254,30 +285,40 @@ SHAMap::gmn_ProcessNodes(MissingNodes& mn, MissingNodes::StackEntry& se)
     node = nullptr;
 }
 
-// Wait for deferred reads to finish and
+// Read the deferred nodes as one batch and
 // process their results
 void
 SHAMap::gmn_ProcessDeferredReads(MissingNodes& mn)
 {
-    // Wait for our deferred reads to finish
+    auto const count = mn.deferredReads_.size();
+
+    // Read the whole frontier at once, rather than waiting
+    // for every read queued by anyone to drain
+    std::vector<uint256> hashes;
+    hashes.reserve(count);
+    for (auto const& [parent, parentID, branch] : mn.deferredReads_)
+        hashes.push_back(parent->getChildHash(branch).as_uint256());
+
     auto const before = std::chrono::steady_clock::now();
-    f_.db().waitReads();
+    auto const objects = f_.db().fetchBatch(hashes, ledgerSeq_);
     auto const after = std::chrono::steady_clock::now();
 
     auto const elapsed =
         std::chrono::duration_cast<std::chrono::milliseconds>(after - before);
-    auto const count = mn.deferredReads_.size();
 
     // Process all deferred reads
     int hits = 0;
-    for (auto const& deferredNode : mn.deferredReads_)
+    for (std::size_t i = 0; i < count; ++i)
     {
+        auto const& deferredNode = mn.deferredReads_[i];
         auto parent = std::get<0>(deferredNode);
         auto const& parentID = std::get<1>(deferredNode);
         auto branch = std::get<2>(deferredNode);
         auto const& nodeHash = parent->getChildHash(branch);
 
-        auto nodePtr = fetchNodeNT(nodeHash, mn.filter_);
+        auto nodePtr = finishFetch(nodeHash, objects[i]);
+        if (!nodePtr && mn.filter_)
+            nodePtr = checkFilter(nodeHash, mn.filter_);
         if (nodePtr)
         {  // Got the node
             ++hits;
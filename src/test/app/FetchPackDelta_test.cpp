@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2018 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/protocol/HashPrefix.h>
+#include <ripple/protocol/messages.h>
+#include <test/jtx.h>
+#include <algorithm>
+
+namespace ripple {
+namespace test {
+
+class FetchPackDelta_test : public beast::unit_test::suite
+{
+    // Build the fetch pack a peer sends when asked for the parent of have
+    static std::shared_ptr<protocol::TMGetObjectByHash>
+    makePack(
+        LedgerMaster& lm,
+        std::shared_ptr<Ledger const> const& have,
+        bool delta,
+        int deltaLimit = 16384)
+    {
+        protocol::TMGetObjectByHash request;
+        request.set_type(protocol::TMGetObjectByHash::otFETCH_PACK);
+        request.set_query(true);
+        request.set_ledgerhash(have->info().hash.data(), uint256::bytes);
+        request.set_delta(delta);
+
+        auto pack = std::make_shared<protocol::TMGetObjectByHash>();
+        lm.buildFetchPack(
+            request,
+            have,
+            lm.getLedgerByHash(have->info().parentHash),
+            *pack,
+            UptimeClock::now(),
+            deltaLimit);
+        return pack;
+    }
+
+    // Whether the pack has the header of a ledger
+    static bool
+    hasHeader(protocol::TMGetObjectByHash const& pack, Ledger const& ledger)
+    {
+        auto const& objects = pack.objects();
+        return std::any_of(objects.begin(), objects.end(), [&](auto const& o) {
+            return !o.has_index() &&
+                uint256{o.hash()} == ledger.info().hash;
+        });
+    }
+
+    // Whether the pack has state entries
+    static bool
+    hasEntries(protocol::TMGetObjectByHash const& pack)
+    {
+        auto const& objects = pack.objects();
+        return std::any_of(objects.begin(), objects.end(), [](auto const& o) {
+            return o.has_index();
+        });
+    }
+
+    // Whether every state node of want that have lacks is in the cache
+    static bool
+    haveNodes(LedgerMaster& lm, Ledger const& have, Ledger const& want)
+    {
+        bool all = true;
+        want.stateMap().visitDifferences(
+            &have.stateMap(), [&](SHAMapAbstractNode& node) {
+                all = all &&
+                    lm.getFetchPack(node.getNodeHash().as_uint256());
+                return all;
+            });
+        return all;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env{*this};
+        auto& lm = env.app().getLedgerMaster();
+
+        env.fund(XRP(10000), "alice", "bob");
+        env.close();
+        auto const before = lm.getClosedLedger();
+
+        // A ledger with many changes, followed by two with few
+        for (int i = 0; i < 10; ++i)
+            env.fund(XRP(1000), Account("user" + std::to_string(i)));
+        env.close();
+        auto const many = lm.getClosedLedger();
+
+        env(noop("bob"));
+        env.close();
+        auto const want = lm.getClosedLedger();
+
+        env(pay("alice", "bob", XRP(100)));
+        env.close();
+        auto const have = lm.getClosedLedger();
+        BEAST_EXPECT(have->info().parentHash == want->info().hash);
+        BEAST_EXPECT(want->info().parentHash == many->info().hash);
+        BEAST_EXPECT(many->info().parentHash == before->info().hash);
+
+        auto const rootHash = want->stateMap().getHash().as_uint256();
+
+        {
+            testcase("build delta");
+            auto const pack = makePack(lm, have, true);
+            BEAST_EXPECT(pack->delta());
+            BEAST_EXPECT(hasEntries(*pack));
+            BEAST_EXPECT(hasHeader(*pack, *want));
+            BEAST_EXPECT(hasHeader(*pack, *many));
+            BEAST_EXPECT(hasHeader(*pack, *before));
+        }
+
+        {
+            testcase("build nodes");
+            auto const pack = makePack(lm, have, false);
+            BEAST_EXPECT(!pack->delta());
+            BEAST_EXPECT(!hasEntries(*pack));
+            BEAST_EXPECT(hasHeader(*pack, *want));
+        }
+
+        {
+            testcase("too many changes");
+
+            // The first ledger falls back to nodes
+            auto pack = makePack(lm, have, true, 1);
+            BEAST_EXPECT(!pack->delta());
+            BEAST_EXPECT(!hasEntries(*pack));
+            BEAST_EXPECT(hasHeader(*pack, *want));
+            BEAST_EXPECT(hasHeader(*pack, *many));
+
+            // A later ledger ends the pack
+            pack = makePack(lm, have, true, 8);
+            BEAST_EXPECT(pack->delta());
+            BEAST_EXPECT(hasEntries(*pack));
+            BEAST_EXPECT(hasHeader(*pack, *many));
+            BEAST_EXPECT(!hasHeader(*pack, *before));
+        }
+
+        {
+            testcase("unrequested delta");
+            BEAST_EXPECT(!lm.takeFetchPackDelta(have->info().hash, 1));
+        }
+
+        {
+            testcase("ledgers we have");
+            lm.addFetchPackDelta({}, makePack(lm, have, true));
+            BEAST_EXPECT(!lm.getFetchPack(rootHash));
+        }
+
+        // Pretend we're missing the ledger
+        lm.clearLedger(want->info().seq);
+
+        {
+            testcase("tampered delta");
+            auto pack = makePack(lm, have, true);
+            BEAST_EXPECT(pack->objects_size() > 1);
+            auto& entry = *pack->mutable_objects(1);
+            BEAST_EXPECT(entry.has_index());
+            entry.mutable_data()->push_back('\0');
+            lm.addFetchPackDelta({}, pack);
+            BEAST_EXPECT(!lm.getFetchPack(rootHash));
+        }
+
+        {
+            testcase("delta");
+            lm.addFetchPackDelta({}, makePack(lm, have, true));
+            BEAST_EXPECT(haveNodes(lm, *have, *want));
+            BEAST_EXPECT(!lm.getFetchPack(
+                many->stateMap().getHash().as_uint256()));
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(FetchPackDelta, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
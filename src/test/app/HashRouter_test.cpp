@@ -277,6 +277,59 @@ class HashRouter_test : public beast::unit_test::suite
         BEAST_EXPECT(router.shouldProcess(key, peer, flags, 1s));
     }
 
+    void
+    testRelayStatus()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 5s, 5);
+        uint256 const key(1);
+
+        {
+            auto const [added, relayed] =
+                router.addSuppressionPeerWithStatus(key, 1);
+            BEAST_EXPECT(added);
+            BEAST_EXPECT(!relayed);
+        }
+        {
+            auto const [added, relayed] =
+                router.addSuppressionPeerWithStatus(key, 2);
+            BEAST_EXPECT(!added);
+            BEAST_EXPECT(!relayed);
+        }
+        auto const now = stopwatch.now();
+        BEAST_EXPECT(router.shouldRelay(key));
+        ++stopwatch;
+        {
+            auto const [added, relayed] =
+                router.addSuppressionPeerWithStatus(key, 3);
+            BEAST_EXPECT(!added);
+            BEAST_EXPECT(relayed && *relayed == now);
+        }
+    }
+
+    void
+    testRequest()
+    {
+        using namespace std::chrono_literals;
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, 5s, 5);
+        uint256 const key(1);
+
+        // A peer announcing a known item does not stop the first request
+        BEAST_EXPECT(router.addSuppressionPeer(key, 1));
+        BEAST_EXPECT(router.shouldRequest(key, 2s));
+        // Later announcers are not asked while the request is pending
+        BEAST_EXPECT(!router.addSuppressionPeer(key, 2));
+        BEAST_EXPECT(!router.shouldRequest(key, 2s));
+        ++stopwatch;
+        BEAST_EXPECT(!router.shouldRequest(key, 2s));
+        // The request went unanswered, so the next announcer is asked
+        ++stopwatch;
+        BEAST_EXPECT(router.shouldRequest(key, 2s));
+        BEAST_EXPECT(!router.shouldRequest(key, 2s));
+    }
+
 public:
     void
     run() override
@@ -288,6 +341,8 @@ public:
         testRelay();
         testRecover();
         testProcess();
+        testRelayStatus();
+        testRequest();
     }
 };
 
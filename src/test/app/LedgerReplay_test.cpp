@@ -21,6 +21,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LedgerReplay.h>
 #include <test/jtx.h>
+#include <thread>
 
 namespace ripple {
 namespace test {
@@ -28,7 +29,7 @@ namespace test {
 struct LedgerReplay_test : public beast::unit_test::suite
 {
     void
-    run() override
+    testReplay()
     {
         testcase("Replay ledger");
 
@@ -55,6 +56,65 @@ struct LedgerReplay_test : public beast::unit_test::suite
 
         BEAST_EXPECT(replayed->info().hash == lastClosed->info().hash);
     }
+
+    void
+    testVerifyConcurrent()
+    {
+        testcase("Verify ledgers concurrently");
+
+        using namespace jtx;
+
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+
+        Env env(*this);
+        env.fund(XRP(100000), alice, bob);
+        env.close();
+
+        std::size_t const count = 8;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            env(pay(alice, bob, XRP(10 + i)));
+            env(pay(bob, alice, XRP(5)));
+            env.close();
+        }
+
+        LedgerMaster& ledgerMaster = env.app().getLedgerMaster();
+        std::vector<std::shared_ptr<Ledger const>> ledgers;
+        for (auto ledger = ledgerMaster.getClosedLedger();
+             ledgers.size() < count;
+             ledger = ledgerMaster.getLedgerByHash(ledger->info().parentHash))
+            ledgers.push_back(ledger);
+
+        std::vector<uint256> built(count);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                auto const& ledger = ledgers[i];
+                auto const parent =
+                    ledgerMaster.getLedgerByHash(ledger->info().parentHash);
+                built[i] = verifyReplay(
+                               LedgerReplay(parent, ledger),
+                               env.app(),
+                               env.journal)
+                               ->info()
+                               .hash;
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        for (std::size_t i = 0; i < count; ++i)
+            BEAST_EXPECT(built[i] == ledgers[i]->info().hash);
+    }
+
+    void
+    run() override
+    {
+        testReplay();
+        testVerifyConcurrent();
+    }
 };
 
 BEAST_DEFINE_TESTSUITE(LedgerReplay, app, ripple);
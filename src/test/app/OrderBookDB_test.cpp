@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2018 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/OrderBookDB.h>
+#include <ripple/core/JobQueue.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class OrderBookDB_test : public beast::unit_test::suite
+{
+    // Close a ledger and wait for it to be published
+    static void
+    close(jtx::Env& env)
+    {
+        env.close();
+        env.app().getJobQueue().rendezvous();
+    }
+
+    void
+    testFollowOffers()
+    {
+        testcase("Books follow offers");
+
+        using namespace jtx;
+
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const alice = Account("alice");
+        auto const USD = gw["USD"];
+        env.fund(XRP(10000), gw, alice);
+        env.trust(USD(1000), alice);
+        close(env);
+        env(pay(gw, alice, USD(500)));
+        close(env);
+
+        auto& db = env.app().getOrderBookDB();
+        BEAST_EXPECT(!db.isBookToXRP(USD));
+        BEAST_EXPECT(db.getBooksByTakerPays(USD).empty());
+
+        // An offer taking USD for XRP creates the book
+        auto const offerSeq = env.seq(alice);
+        env(offer(alice, USD(100), XRP(100)));
+        close(env);
+        BEAST_EXPECT(db.isBookToXRP(USD));
+        auto const books = db.getBooksByTakerPays(USD);
+        BEAST_EXPECT(books.size() == 1);
+        BEAST_EXPECT(books.size() == 1 && isXRP(books[0]->getCurrencyOut()));
+
+        // Cancelling the last offer removes it
+        env(offer_cancel(alice, offerSeq));
+        close(env);
+        BEAST_EXPECT(!db.isBookToXRP(USD));
+        BEAST_EXPECT(db.getBooksByTakerPays(USD).empty());
+
+        // So does consuming it
+        env(offer(alice, USD(100), XRP(100)));
+        close(env);
+        BEAST_EXPECT(db.isBookToXRP(USD));
+        env(offer(gw, XRP(100), USD(100)));
+        close(env);
+        BEAST_EXPECT(!db.isBookToXRP(USD));
+        BEAST_EXPECT(db.getBooksByTakerPays(USD).empty());
+    }
+
+    void
+    testNoRescan()
+    {
+        testcase("Full update only after a gap");
+
+        using namespace jtx;
+
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const EUR = gw["EUR"];
+        env.fund(XRP(10000), gw);
+        close(env);
+        close(env);
+        close(env);
+        env(noop(gw));
+        close(env);
+
+        auto& db = env.app().getOrderBookDB();
+        auto& ledgerMaster = env.app().getLedgerMaster();
+
+        // A book added from the open ledger is dropped once a validated
+        // ledger doesn't have it
+        Book const book{EUR.issue(), xrpIssue()};
+        db.addOrderBook(book);
+        BEAST_EXPECT(db.isBookToXRP(EUR));
+        close(env);
+        BEAST_EXPECT(!db.isBookToXRP(EUR));
+
+        // Until then it only survives while the books are not rebuilt from
+        // the ledger. The books followed the last (empty) ledger, so
+        // setting up from it again doesn't rebuild them.
+        db.addOrderBook(book);
+        db.setup(ledgerMaster.getPublishedLedger());
+        BEAST_EXPECT(db.isBookToXRP(EUR));
+
+        // A ledger that doesn't follow it
+        auto const seq = ledgerMaster.getPublishedLedger()->info().seq;
+        db.setup(ledgerMaster.getLedgerBySeq(seq - 3));
+        BEAST_EXPECT(!db.isBookToXRP(EUR));
+    }
+
+public:
+    void
+    run() override
+    {
+        testFollowOffers();
+        testNoRescan();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OrderBookDB, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2018 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/paths/PathRankCache.h>
+#include <ripple/app/paths/RippleCalc.h>
+#include <ripple/ledger/PaymentSandbox.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class PathRankCache_test : public beast::unit_test::suite
+{
+    // Rank the default paths of a payment, recording what it reads
+    void
+    rank(
+        jtx::Env& env,
+        PathRankCache& rankCache,
+        uint256 const& key,
+        RippleLineCache const& cache,
+        jtx::Account const& src,
+        jtx::Account const& dst,
+        STAmount const& srcAmount,
+        STAmount const& dstAmount)
+    {
+        auto const& ledger = *cache.getLedger();
+
+        PathRankCache::Dependencies deps;
+        DependencyRecorder recorder(ledger, deps);
+        PaymentSandbox sandbox(&recorder, tapNONE);
+
+        auto const rc = path::RippleCalc::rippleCalculate(
+            sandbox,
+            srcAmount,
+            dstAmount,
+            dst.id(),
+            src.id(),
+            STPathSet(),
+            env.app().logs());
+        BEAST_EXPECT(rc.result() == tesSUCCESS);
+        BEAST_EXPECT(!deps.keys.empty());
+
+        rankCache.insert(
+            key,
+            ledger,
+            {rc.result(), rc.actualAmountOut, 0},
+            std::move(deps));
+    }
+
+    // Close a ledger and move the caches on to it
+    static std::shared_ptr<RippleLineCache>
+    advance(
+        jtx::Env& env,
+        PathRankCache& rankCache,
+        RippleLineCache& cache)
+    {
+        env.close();
+        auto next = std::make_shared<RippleLineCache>(env.closed(), cache);
+        rankCache.update(*next);
+        return next;
+    }
+
+    void
+    testInvalidation()
+    {
+        testcase("Invalidation");
+
+        using namespace jtx;
+
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const gw2 = Account("gateway2");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const carol = Account("carol");
+        auto const dan = Account("dan");
+        auto const erin = Account("erin");
+        auto const USD = gw["USD"];
+        auto const EUR = gw2["EUR"];
+
+        env.fund(XRP(10000), gw, gw2, alice, bob, carol, dan, erin);
+        env.trust(USD(1000), alice, bob, carol);
+        env.trust(EUR(1000), erin);
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env(pay(gw, carol, USD(100)));
+        auto const offerSeq = env.seq(carol);
+        env(offer(carol, XRP(100), USD(100)));
+        env.close();
+
+        PathRankCache rankCache;
+        auto cache = std::make_shared<RippleLineCache>(env.closed());
+        rankCache.update(*cache);
+
+        // Alice pays bob through the gateway's trust lines, and dan pays
+        // him through carol's offer
+        uint256 const lineKey(1);
+        uint256 const offerKey(2);
+        rank(env, rankCache, lineKey, *cache, alice, bob, USD(10), USD(10));
+        rank(env, rankCache, offerKey, *cache, dan, bob, XRP(20), USD(10));
+        BEAST_EXPECT(rankCache.find(lineKey, *cache->getLedger()));
+        BEAST_EXPECT(rankCache.find(offerKey, *cache->getLedger()));
+
+        // Neither depends on an unrelated trust line
+        env(pay(gw2, erin, EUR(5)));
+        cache = advance(env, rankCache, *cache);
+        BEAST_EXPECT(rankCache.find(lineKey, *cache->getLedger()));
+        BEAST_EXPECT(rankCache.find(offerKey, *cache->getLedger()));
+
+        // Changing alice's trust line only affects her payment
+        env(pay(alice, gw, USD(1)));
+        cache = advance(env, rankCache, *cache);
+        BEAST_EXPECT(!rankCache.find(lineKey, *cache->getLedger()));
+        BEAST_EXPECT(rankCache.find(offerKey, *cache->getLedger()));
+
+        // Cancelling the offer affects dan's payment
+        env(offer_cancel(carol, offerSeq));
+        cache = advance(env, rankCache, *cache);
+        BEAST_EXPECT(!rankCache.find(offerKey, *cache->getLedger()));
+    }
+
+    void
+    testUnused()
+    {
+        testcase("Unused results");
+
+        using namespace jtx;
+
+        Env env(*this);
+        auto const gw = Account("gateway");
+        auto const alice = Account("alice");
+        auto const bob = Account("bob");
+        auto const USD = gw["USD"];
+
+        env.fund(XRP(10000), gw, alice, bob);
+        env.trust(USD(1000), alice, bob);
+        env.close();
+        env(pay(gw, alice, USD(100)));
+        env.close();
+
+        PathRankCache rankCache;
+        auto cache = std::make_shared<RippleLineCache>(env.closed());
+        rankCache.update(*cache);
+
+        uint256 const key(1);
+        rank(env, rankCache, key, *cache, alice, bob, USD(10), USD(10));
+
+        // A result is kept for a ledger without being used, then dropped
+        cache = advance(env, rankCache, *cache);
+        cache = advance(env, rankCache, *cache);
+        BEAST_EXPECT(!rankCache.find(key, *cache->getLedger()));
+
+        // Skipping a ledger drops everything
+        rank(env, rankCache, key, *cache, alice, bob, USD(10), USD(10));
+        env.close();
+        cache = advance(env, rankCache, *cache);
+        BEAST_EXPECT(!rankCache.find(key, *cache->getLedger()));
+    }
+
+public:
+    void
+    run() override
+    {
+        testInvalidation();
+        testUnused();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PathRankCache, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
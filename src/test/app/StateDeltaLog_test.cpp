@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2018 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/StateDeltaLog.h>
+#include <ripple/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class StateDeltaLog_test : public beast::unit_test::suite
+{
+    // The log must agree with the ledger's own state map
+    static bool
+    matches(
+        StateDeltaLog const& log,
+        std::shared_ptr<Ledger const> const& ledger,
+        uint256 const& key)
+    {
+        auto const logged =
+            log.lookup(ledger->info().seq, ledger->info().hash, key);
+        if (!logged)
+            return false;
+        auto const& item = ledger->stateMap().peekItem(key);
+        if (!*logged || !item)
+            return !*logged && !item;
+        return (*logged)->peekData() == item->peekData();
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env{*this};
+        Account const alice{"alice"};
+        Account const bob{"bob"};
+
+        StateDeltaLog log(3, env.journal);
+
+        auto const append = [&]() {
+            env.close();
+            auto const ledger = env.app().getLedgerMaster().getClosedLedger();
+            log.append(ledger);
+            return ledger;
+        };
+
+        // Nothing to compare the first ledger against
+        append();
+        BEAST_EXPECT(!log.range());
+
+        env.fund(XRP(1000), alice);
+        auto const l1 = append();
+        BEAST_EXPECT(
+            log.range() == std::make_pair(l1->info().seq, l1->info().seq));
+        auto const aliceKey = keylet::account(alice).key;
+        auto const bobKey = keylet::account(bob).key;
+        BEAST_EXPECT(matches(log, l1, aliceKey));
+        BEAST_EXPECT(!log.lookup(l1->info().seq, l1->info().hash, bobKey));
+
+        // Only answer for the ledger that was logged
+        BEAST_EXPECT(!log.lookup(
+            l1->info().seq, l1->info().hash + uint256(1), aliceKey));
+        BEAST_EXPECT(
+            !log.lookup(l1->info().seq + 1, l1->info().hash, aliceKey));
+
+        env.fund(XRP(1000), bob);
+        auto const l2 = append();
+        BEAST_EXPECT(matches(log, l1, aliceKey));
+        BEAST_EXPECT(matches(log, l2, aliceKey));
+        BEAST_EXPECT(matches(log, l2, bobKey));
+        BEAST_EXPECT(!log.lookup(l1->info().seq, l1->info().hash, bobKey));
+
+        env(pay(alice, bob, XRP(10)));
+        auto const l3 = append();
+        BEAST_EXPECT(matches(log, l2, aliceKey));
+        BEAST_EXPECT(matches(log, l3, aliceKey));
+        BEAST_EXPECT(matches(log, l3, bobKey));
+        BEAST_EXPECT(
+            l2->stateMap().peekItem(aliceKey)->peekData() !=
+            l3->stateMap().peekItem(aliceKey)->peekData());
+
+        // The oldest ledger falls out of the window
+        auto const l4 = append();
+        BEAST_EXPECT(
+            log.range() == std::make_pair(l2->info().seq, l4->info().seq));
+        BEAST_EXPECT(!log.lookup(l1->info().seq, l1->info().hash, aliceKey));
+        BEAST_EXPECT(matches(log, l4, aliceKey));
+
+        // A ledger that doesn't follow the last one restarts the log
+        log.append(l2);
+        BEAST_EXPECT(!log.range());
+        BEAST_EXPECT(!log.lookup(l4->info().seq, l4->info().hash, aliceKey));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StateDeltaLog, app, ripple);
+
+}  // namespace test
+}  // namespace ripple
@@ -150,6 +150,30 @@ public:
         BEAST_EXPECT(n != -n);
     }
 
+    void
+    testNormalize()
+    {
+        testcase("IOU normalize");
+
+        IOUAmount const small(1, 0);
+        BEAST_EXPECT(small.mantissa() == 1000000000000000ll);
+        BEAST_EXPECT(small.exponent() == -15);
+
+        IOUAmount const big(-123456789012345678ll, 0);
+        BEAST_EXPECT(big.mantissa() == -1234567890123456ll);
+        BEAST_EXPECT(big.exponent() == 2);
+
+        BEAST_EXPECT(IOUAmount(1, -93) == beast::zero);
+
+        // Aligning exponents drops the low digits of the smaller value
+        IOUAmount sum(1234567890123456ll, -10);
+        sum += IOUAmount(-9999999999999999ll, -13);
+        BEAST_EXPECT(sum == IOUAmount(1224567890123457ll, -10));
+
+        IOUAmount const one(1, 0);
+        BEAST_EXPECT(one + IOUAmount(-1, -80) == one);
+    }
+
     void
     testToString()
     {
@@ -262,6 +286,7 @@ run() override
     testSigNum();
     testBeastZero();
     testComparisons();
+    testNormalize();
     testToString();
     testMulRatio();
 }
@@ -1062,6 +1062,67 @@ public:
         }
     }
 
+    void
+    testLatency()
+    {
+        using namespace std::chrono;
+
+        PerfLogParent parent{j_};
+        auto perfLog{getPerfLog(parent, WithFile::no)};
+
+        // Nothing recorded yet, so nothing is reported.
+        {
+            Json::Value const latency{perfLog->latencyJson()};
+            BEAST_EXPECT(latency[jss::rpc].size() == 0);
+            BEAST_EXPECT(latency[jss::job_queue].size() == 0);
+        }
+
+        // 99 fast jobs and one slow one.
+        perfLog->resizeJobs(1);
+        for (int i = 0; i < 100; ++i)
+        {
+            perfLog->jobStart(
+                jtCLIENT, microseconds{100}, steady_clock::now(), 0);
+            perfLog->jobFinish(
+                jtCLIENT, microseconds{i == 99 ? 50000 : 1000}, 0);
+        }
+
+        Json::Value const jq{perfLog->latencyJson()[jss::job_queue]};
+        BEAST_EXPECT(jq.size() == 1);
+
+        auto const name = JobTypes::instance().get(jtCLIENT).name();
+        if (!BEAST_EXPECT(jq.isMember(name)))
+            return;
+
+        // Percentiles are reported as the top of their bucket, which is at
+        // most a quarter above the recorded value.
+        auto near = [](Json::Value const& v, std::uint64_t us) {
+            auto const reported = jsonToUint64(v);
+            return reported >= us && reported <= us + us / 4;
+        };
+
+        Json::Value const& queued = jq[name][jss::queued_duration_us];
+        BEAST_EXPECT(queued[jss::count] == "100");
+        BEAST_EXPECT(near(queued["p50"], 100));
+        BEAST_EXPECT(near(queued["max"], 100));
+
+        Json::Value const& running = jq[name][jss::running_duration_us];
+        BEAST_EXPECT(running[jss::count] == "100");
+        BEAST_EXPECT(near(running["p50"], 1000));
+        BEAST_EXPECT(near(running["p99"], 1000));
+        BEAST_EXPECT(near(running["p999"], 50000));
+        BEAST_EXPECT(near(running["max"], 50000));
+
+        // An RPC call is reported once it ends.
+        perfLog->rpcStart("server_info", 1);
+        BEAST_EXPECT(perfLog->latencyJson()[jss::rpc].size() == 0);
+        perfLog->rpcFinish("server_info", 1);
+        Json::Value const rpc{perfLog->latencyJson()[jss::rpc]};
+        BEAST_EXPECT(rpc.size() == 1);
+        BEAST_EXPECT(
+            rpc["server_info"][jss::duration_us][jss::count] == "1");
+    }
+
     void
     testRotate(WithFile withFile)
     {
@@ -1131,6 +1192,7 @@ public:
         testJobs(WithFile::yes);
         testInvalidID(WithFile::no);
         testInvalidID(WithFile::yes);
+        testLatency();
         testRotate(WithFile::no);
         testRotate(WithFile::yes);
     }
@@ -547,6 +547,20 @@ public:
                 fetchCopyOfBatch(*db, &copy, batch);
                 BEAST_EXPECT(areBatchesEqual(batch, copy));
             }
+
+            {
+                // Read it back with one call, along with a missing object
+                std::vector<uint256> hashes;
+                for (auto const& object : batch)
+                    hashes.push_back(object->getHash());
+                hashes.push_back(uint256{});
+
+                auto copy = db->fetchBatch(hashes, 0);
+                BEAST_EXPECT(copy.size() == hashes.size());
+                BEAST_EXPECT(copy.back() == nullptr);
+                copy.pop_back();
+                BEAST_EXPECT(areBatchesEqual(batch, copy));
+            }
         }
 
         if (testPersistence)
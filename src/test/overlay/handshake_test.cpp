@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2020 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/impl/Handshake.h>
+
+namespace ripple {
+
+namespace test {
+
+class handshake_test : public beast::unit_test::suite
+{
+public:
+    handshake_test() = default;
+
+    void
+    testFeatureHeader()
+    {
+        testcase("Feature header parsing");
+
+        boost::beast::http::fields headers;
+        BEAST_EXPECT(!getFeatureValue(headers, FEATURE_TXRR));
+        BEAST_EXPECT(!featureEnabled(headers, FEATURE_TXRR));
+
+        headers.insert("X-Protocol-Ctl", "foo=bar; txrr = 1 ;baz");
+        auto const value = getFeatureValue(headers, FEATURE_TXRR);
+        BEAST_EXPECT(value && *value == "1");
+        BEAST_EXPECT(featureEnabled(headers, FEATURE_TXRR));
+        BEAST_EXPECT(!featureEnabled(headers, "foo"));
+        BEAST_EXPECT(!getFeatureValue(headers, "baz"));
+        BEAST_EXPECT(peerFeatureEnabled(headers, FEATURE_TXRR, true));
+        BEAST_EXPECT(!peerFeatureEnabled(headers, FEATURE_TXRR, false));
+    }
+
+    void
+    testFeatureNegotiation()
+    {
+        testcase("Feature negotiation");
+
+        BEAST_EXPECT(makeFeaturesRequestHeader(false, false).empty());
+
+        boost::beast::http::fields request;
+        request.insert("X-Protocol-Ctl", makeFeaturesRequestHeader(true, true));
+        BEAST_EXPECT(featureEnabled(request, FEATURE_VPRR));
+        BEAST_EXPECT(featureEnabled(request, FEATURE_TXRR));
+
+        boost::beast::http::fields response;
+        response.insert(
+            "X-Protocol-Ctl", makeFeaturesResponseHeader(request, false, true));
+        BEAST_EXPECT(!featureEnabled(response, FEATURE_VPRR));
+        BEAST_EXPECT(featureEnabled(response, FEATURE_TXRR));
+
+        BEAST_EXPECT(
+            makeFeaturesResponseHeader(request, false, false).empty());
+        BEAST_EXPECT(
+            makeFeaturesResponseHeader(boost::beast::http::fields{}, true, true)
+                .empty());
+    }
+
+    void
+    run() override
+    {
+        testFeatureHeader();
+        testFeatureNegotiation();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(handshake, overlay, ripple);
+
+}  // namespace test
+
+}  // namespace ripple
@@ -0,0 +1,297 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2020 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/app/misc/HashRouter.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/overlay/Slot.h>
+#include <ripple/overlay/Squelch.h>
+#include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/digest.h>
+
+#include <chrono>
+#include <map>
+
+namespace ripple {
+
+namespace test {
+
+/** Clock which is only advanced by the test */
+class ManualClock
+{
+public:
+    using rep = std::int64_t;
+    using period = std::milli;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static bool const is_steady = false;
+
+    static void
+    advance(duration d) noexcept
+    {
+        now_ += d;
+    }
+
+    static time_point
+    now() noexcept
+    {
+        return now_;
+    }
+
+private:
+    inline static time_point now_ = time_point(std::chrono::seconds(0));
+};
+
+/** Records the squelch and unsquelch requests made by the slots */
+class TestHandler : public squelch::SquelchHandler
+{
+public:
+    void
+    squelch(PublicKey const&, Peer::id_t id, std::uint32_t duration)
+        const override
+    {
+        squelched_[id] = duration;
+    }
+
+    void
+    unsquelch(PublicKey const&, Peer::id_t id) const override
+    {
+        squelched_.erase(id);
+    }
+
+    mutable std::map<Peer::id_t, std::uint32_t> squelched_;
+};
+
+class reduce_relay_test : public beast::unit_test::suite
+{
+    using Slots = squelch::Slots<ManualClock>;
+
+    static constexpr std::uint16_t nPeers = 10;
+
+    beast::Journal const j_{beast::Journal::getNullSink()};
+
+    /** Send messages from the validator round robin over all peers until
+        the slot selects the peers.
+     */
+    void
+    select(Slots& slots, PublicKey const& validator)
+    {
+        for (int i = 0; i <= squelch::MAX_MESSAGE_THRESHOLD + 1; ++i)
+        {
+            auto const key = sha512Half(validator, i);
+            for (Peer::id_t id = 0; id < nPeers; ++id)
+                slots.updateSlotAndSquelch(key, validator, id);
+            ManualClock::advance(std::chrono::milliseconds(100));
+        }
+    }
+
+    void
+    testSquelch()
+    {
+        testcase("Squelch");
+
+        using namespace std::chrono;
+        squelch::Squelch<ManualClock> squelch(j_);
+        auto const validator = randomKeyPair(KeyType::ed25519).first;
+
+        BEAST_EXPECT(squelch.expireSquelch(validator));
+        BEAST_EXPECT(!squelch.addSquelch(
+            validator, squelch::MIN_UNSQUELCH_EXPIRE - seconds{1}));
+        BEAST_EXPECT(!squelch.addSquelch(
+            validator, squelch::MAX_UNSQUELCH_EXPIRE_PEERS + seconds{1}));
+        BEAST_EXPECT(squelch.expireSquelch(validator));
+
+        BEAST_EXPECT(
+            squelch.addSquelch(validator, squelch::MIN_UNSQUELCH_EXPIRE));
+        BEAST_EXPECT(!squelch.expireSquelch(validator));
+        ManualClock::advance(squelch::MIN_UNSQUELCH_EXPIRE + seconds{1});
+        BEAST_EXPECT(squelch.expireSquelch(validator));
+
+        BEAST_EXPECT(
+            squelch.addSquelch(validator, squelch::MIN_UNSQUELCH_EXPIRE));
+        squelch.removeSquelch(validator);
+        BEAST_EXPECT(squelch.expireSquelch(validator));
+    }
+
+    void
+    testSelection()
+    {
+        testcase("Peer selection");
+
+        TestHandler handler;
+        Slots slots(handler, j_);
+        auto const validator = randomKeyPair(KeyType::ed25519).first;
+
+        select(slots, validator);
+
+        auto const selected = slots.getSelected(validator);
+        BEAST_EXPECT(selected.size() == squelch::MAX_SELECTED_PEERS);
+        BEAST_EXPECT(
+            handler.squelched_.size() == nPeers - squelch::MAX_SELECTED_PEERS);
+        BEAST_EXPECT(
+            slots.inState(validator, squelch::PeerState::Squelched) ==
+            static_cast<std::uint16_t>(nPeers - squelch::MAX_SELECTED_PEERS));
+        for (auto const& [id, duration] : handler.squelched_)
+        {
+            BEAST_EXPECT(selected.find(id) == selected.end());
+            BEAST_EXPECT(
+                duration >= squelch::MIN_UNSQUELCH_EXPIRE.count() &&
+                duration <= squelch::MAX_UNSQUELCH_EXPIRE.count());
+        }
+    }
+
+    void
+    testRepeatedMessage()
+    {
+        testcase("Repeated message");
+
+        TestHandler handler;
+        Slots slots(handler, j_);
+        auto const validator = randomKeyPair(KeyType::ed25519).first;
+
+        // Peer 0 keeps sending the first message while the others relay
+        // each new one. A repeated message is only counted once, so peer 0
+        // can't get itself selected.
+        auto const first = sha512Half(validator, 0);
+        for (int i = 0; i <= squelch::MAX_MESSAGE_THRESHOLD + 1; ++i)
+        {
+            auto const key = sha512Half(validator, i);
+            for (Peer::id_t id = 0; id < nPeers; ++id)
+                slots.updateSlotAndSquelch(
+                    id == 0 ? first : key, validator, id);
+            ManualClock::advance(std::chrono::milliseconds(100));
+        }
+
+        auto const selected = slots.getSelected(validator);
+        BEAST_EXPECT(selected.size() == squelch::MAX_SELECTED_PEERS);
+        BEAST_EXPECT(selected.find(0) == selected.end());
+        BEAST_EXPECT(handler.squelched_.count(0) == 1);
+
+        // Peers only repeating a message never select anyone
+        auto const other = randomKeyPair(KeyType::ed25519).first;
+        auto const key = sha512Half(other, 0);
+        for (int i = 0; i <= squelch::MAX_MESSAGE_THRESHOLD + 1; ++i)
+        {
+            for (Peer::id_t id = 0; id < nPeers; ++id)
+                slots.updateSlotAndSquelch(key, other, id);
+        }
+        BEAST_EXPECT(slots.getSelected(other).empty());
+    }
+
+    void
+    testFirstSender()
+    {
+        testcase("First sender");
+
+        TestHandler handler;
+        Slots slots(handler, j_);
+        TestStopwatch stopwatch;
+        HashRouter router(stopwatch, std::chrono::seconds(300), 5);
+        auto const validator = randomKeyPair(KeyType::ed25519).first;
+
+        // Peer 0 is always the first to send each message. It and any peer
+        // sending the message before it is relayed are counted once it is
+        // verified and relayed; the others are counted as duplicates.
+        Peer::id_t const peers = squelch::MAX_SELECTED_PEERS;
+        for (int i = 0; i <= squelch::MAX_MESSAGE_THRESHOLD + 1; ++i)
+        {
+            auto const key = sha512Half(validator, i);
+            BEAST_EXPECT(router.addSuppressionPeer(key, 0));
+            BEAST_EXPECT(!router.addSuppressionPeer(key, 1));
+            auto const toSkip = router.shouldRelay(key);
+            if (!BEAST_EXPECT(toSkip && toSkip->size() == 2))
+                return;
+            for (auto const id : *toSkip)
+                slots.updateSlotAndSquelch(key, validator, id);
+            for (Peer::id_t id = 2; id < peers; ++id)
+            {
+                auto const [added, relayed] =
+                    router.addSuppressionPeerWithStatus(key, id);
+                if (!added && relayed)
+                    slots.updateSlotAndSquelch(key, validator, id);
+            }
+            ManualClock::advance(std::chrono::milliseconds(100));
+        }
+
+        // Every peer reached the threshold, so all of them are selected
+        auto const selected = slots.getSelected(validator);
+        BEAST_EXPECT(selected.size() == squelch::MAX_SELECTED_PEERS);
+        BEAST_EXPECT(selected.count(0) == 1);
+        BEAST_EXPECT(selected.count(1) == 1);
+        BEAST_EXPECT(handler.squelched_.empty());
+    }
+
+    void
+    testDeleteSelected()
+    {
+        testcase("Delete selected peer");
+
+        TestHandler handler;
+        Slots slots(handler, j_);
+        auto const validator = randomKeyPair(KeyType::ed25519).first;
+
+        select(slots, validator);
+        auto const selected = slots.getSelected(validator);
+        BEAST_EXPECT(!selected.empty());
+        BEAST_EXPECT(!handler.squelched_.empty());
+
+        // Losing a selected peer unsquelches everyone and restarts counting
+        slots.deletePeer(*selected.begin(), true);
+        BEAST_EXPECT(handler.squelched_.empty());
+        BEAST_EXPECT(slots.getSelected(validator).empty());
+        BEAST_EXPECT(
+            slots.inState(validator, squelch::PeerState::Counting) ==
+            static_cast<std::uint16_t>(nPeers - 1));
+    }
+
+    void
+    testIdlePeers()
+    {
+        testcase("Idle peers");
+
+        TestHandler handler;
+        Slots slots(handler, j_);
+        auto const validator = randomKeyPair(KeyType::ed25519).first;
+
+        select(slots, validator);
+        BEAST_EXPECT(!handler.squelched_.empty());
+
+        // The selected peers stop relaying the validator's messages
+        ManualClock::advance(squelch::IDLED + std::chrono::seconds{1});
+        slots.deleteIdlePeers();
+        BEAST_EXPECT(handler.squelched_.empty());
+        BEAST_EXPECT(slots.getSelected(validator).empty());
+    }
+
+    void
+    run() override
+    {
+        testSquelch();
+        testSelection();
+        testRepeatedMessage();
+        testFirstSender();
+        testDeleteSelected();
+        testIdlePeers();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(reduce_relay, overlay, ripple);
+
+}  // namespace test
+
+}  // namespace ripple
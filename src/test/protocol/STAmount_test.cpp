@@ -509,6 +509,75 @@ public:
 
     //--------------------------------------------------------------------------
 
+    void
+    testNormalization()
+    {
+        testcase("normalization");
+
+        {
+            // Mantissas are scaled into range in a single step
+            STAmount const small(noIssue(), 1, 0);
+            BEAST_EXPECT(small.mantissa() == STAmount::cMinValue);
+            BEAST_EXPECT(small.exponent() == -15);
+
+            STAmount const big(noIssue(), std::uint64_t{123456789012345678}, 0);
+            BEAST_EXPECT(big.mantissa() == 1234567890123456ull);
+            BEAST_EXPECT(big.exponent() == 2);
+
+            // Scaling up stops at the smallest exponent
+            STAmount const tiny(noIssue(), 1, STAmount::cMinOffset + 3);
+            BEAST_EXPECT(tiny == beast::zero);
+
+            // Scaling down stops at the largest exponent
+            STAmount const largest(
+                noIssue(), 10 * STAmount::cMinValue, STAmount::cMaxOffset - 1);
+            BEAST_EXPECT(largest.mantissa() == STAmount::cMinValue);
+            BEAST_EXPECT(largest.exponent() == STAmount::cMaxOffset);
+            except<std::runtime_error>([] {
+                STAmount(
+                    noIssue(), 10 * STAmount::cMinValue, STAmount::cMaxOffset);
+            });
+        }
+
+        {
+            // Aligning exponents drops the low digits of the smaller value
+            STAmount const a(noIssue(), std::uint64_t{1234567890123456}, -10);
+            STAmount const b(noIssue(), std::uint64_t{9999999999999999}, -13);
+            STAmount const sum = a + b;
+            BEAST_EXPECT(sum.mantissa() == 1244567890123455ull);
+            BEAST_EXPECT(sum.exponent() == -10);
+            STAmount const diff = a - b;
+            BEAST_EXPECT(diff.mantissa() == 1224567890123457ull);
+            BEAST_EXPECT(diff.exponent() == -10);
+
+            // A value more than 16 digits smaller vanishes entirely
+            STAmount const one(noIssue(), 1);
+            BEAST_EXPECT(one + STAmount(noIssue(), 1, -20) == one);
+            BEAST_EXPECT(one - STAmount(noIssue(), 1, -80) == one);
+        }
+
+        {
+            // Native operands are scaled up to the IOU mantissa range
+            BEAST_EXPECT(
+                divide(STAmount(1), STAmount(noIssue(), 3), noIssue()) ==
+                STAmount(noIssue(), std::uint64_t{3333333333333333}, -16));
+            BEAST_EXPECT(
+                multiply(
+                    STAmount(2000000), STAmount(noIssue(), 5, -1), noIssue()) ==
+                STAmount(noIssue(), 1000000));
+            BEAST_EXPECT(
+                mulRound(
+                    STAmount(7), STAmount(noIssue(), 1, -1), noIssue(), true) ==
+                STAmount(noIssue(), 7, -1));
+            BEAST_EXPECT(
+                divRound(
+                    STAmount(noIssue(), 7), STAmount(10), noIssue(), false) ==
+                STAmount(noIssue(), 7, -1));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     void
     testUnderflow()
     {
@@ -683,6 +752,7 @@ public:
         testNativeCurrency();
         testCustomCurrency();
         testArithmetic();
+        testNormalization();
         testUnderflow();
         testRounding();
         testConvertXRP();
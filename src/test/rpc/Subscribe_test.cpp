@@ -18,8 +18,11 @@
 #include <ripple/app/main/LoadManager.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/basics/StringUtilities.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/core/ConfigSections.h>
+#include <ripple/ledger/TxMeta.h>
+#include <ripple/protocol/STTx.h>
 #include <ripple/protocol/jss.h>
 #include <test/jtx.h>
 #include <test/jtx/WSClient.h>
@@ -288,6 +291,81 @@ public:
         BEAST_EXPECT(jv[jss::status] == "success");
     }
 
+    void
+    testBinaryTransactions()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+        auto wsc = makeWSClient(env.app().config());
+        Json::Value stream;
+
+        {
+            // RPC subscribe to transactions stream in binary
+            stream[jss::streams] = Json::arrayValue;
+            stream[jss::streams].append("transactions");
+            stream[jss::binary] = true;
+            auto jv = wsc->invoke("subscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+        }
+
+        {
+            env.fund(XRP(10000), "alice");
+            env.close();
+
+            // Check stream update for payment transaction
+            BEAST_EXPECT(wsc->findMsg(5s, [&](auto const& jv) {
+                if (jv.isMember(jss::transaction) || !jv[jss::validated])
+                    return false;
+
+                auto const txBlob = strUnHex(jv[jss::tx_blob].asString());
+                auto const metaBlob = strUnHex(jv[jss::meta].asString());
+                if (!txBlob || !metaBlob)
+                    return false;
+
+                SerialIter sit(makeSlice(*txBlob));
+                STTx const tx(sit);
+                TxMeta const meta(
+                    tx.getTransactionID(),
+                    jv[jss::ledger_index].asUInt(),
+                    *metaBlob);
+
+                return tx.getTxnType() == ttPAYMENT &&
+                    tx.getAccountID(sfDestination) == Account("alice").id() &&
+                    to_string(tx.getTransactionID()) ==
+                    jv[jss::hash].asString() &&
+                    meta.getResultTER() == tesSUCCESS;
+            }));
+        }
+
+        {
+            // RPC unsubscribe
+            auto jv = wsc->invoke("unsubscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+        }
+
+        {
+            // Subscribing again without binary gets JSON
+            stream.removeMember(jss::binary);
+            auto jv = wsc->invoke("subscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+
+            env.fund(XRP(10000), "bob");
+            env.close();
+
+            BEAST_EXPECT(wsc->findMsg(5s, [&](auto const& jv) {
+                return jv[jss::transaction][jss::TransactionType] ==
+                    jss::Payment &&
+                    jv[jss::transaction][jss::Destination] ==
+                    Account("bob").human() &&
+                    !jv.isMember(jss::tx_blob);
+            }));
+
+            jv = wsc->invoke("unsubscribe", stream);
+            BEAST_EXPECT(jv[jss::status] == "success");
+        }
+    }
+
     void
     testManifests()
     {
@@ -697,6 +775,7 @@ public:
         testServer();
         testLedger();
         testTransactions();
+        testBinaryTransactions();
         testManifests();
         testValidations();
         testSubErrors(true);
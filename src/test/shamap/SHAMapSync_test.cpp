@@ -113,6 +113,20 @@ public:
         source.visitLeaves([&count](auto const& item) { ++count; });
         BEAST_EXPECT(count == items);
 
+        {
+            // Visiting every branch of the root reaches every node
+            // but the root itself
+            int nodes = 0;
+            source.visitNodes([&nodes](auto const&) { return ++nodes; });
+
+            int branchNodes = 0;
+            for (int branch = 0; branch < 16; ++branch)
+                source.visitBranch(branch, [&branchNodes](auto const&) {
+                    return ++branchNodes;
+                });
+            BEAST_EXPECT(branchNodes + 1 == nodes);
+        }
+
         std::vector<SHAMapMissingNode> missingNodes;
         source.walkMap(missingNodes, 2048);
         BEAST_EXPECT(missingNodes.empty());